@@ -0,0 +1,295 @@
+// bench.cpp
+//
+// Sorting benchmark suite: runs every algorithm in sort.hpp over a grid of sizes,
+// input distributions and element types, and prints one CSV row per combination.
+// The selection algorithms run with k = SELECT_K (or the median for quick_select),
+// to compare them against the full sorts when k is much smaller than n.
+//
+// usage: bench [max_n] [algorithm]
+//   max_n      largest input size, sizes are the powers of ten from 10 up to max_n (default 1000000, at most 100000000)
+//   algorithm  only run algorithms whose name contains this string
+//
+// build: g++ -std=c++17 -O2 -pthread bench.cpp -o bench
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>   // For timing
+#include <cstdlib>  // For std::malloc / std::free
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <atomic>
+#include <algorithm>
+#include <random>
+#include "sort.hpp"
+
+using namespace std;
+
+//number of heap allocations made since the last reset
+static atomic<size_t> allocation_count(0);
+//number of comparisons and element moves made by the counting run
+static atomic<size_t> comparison_count(0);
+static atomic<size_t> move_count(0);
+
+//keep the replaced delete out of line, otherwise gcc sees operator new paired with free and warns
+#if defined(__GNUC__)
+#define BENCH_NOINLINE __attribute__((noinline))
+#else
+#define BENCH_NOINLINE
+#endif
+
+void* operator new(size_t size) {
+    allocation_count.fetch_add(1, memory_order_relaxed);
+    if (void *ptr = malloc(size == 0 ? 1 : size)) return ptr;
+    throw bad_alloc();
+}
+
+BENCH_NOINLINE void operator delete(void *ptr) noexcept {
+    free(ptr);
+}
+
+BENCH_NOINLINE void operator delete(void *ptr, size_t) noexcept {
+    free(ptr);
+}
+
+//64 byte record sorted by its key, the payload only has to be moved around
+struct record64 {
+    int64_t key;
+    char payload[56];
+
+    bool operator<(const record64 &other) const { return key < other.key; }
+    bool operator==(const record64 &other) const { return key == other.key; }
+};
+
+//element wrapper counting every copy and move, used by the counting run
+template<typename T>
+struct tracked {
+    T value;
+
+    tracked() = default;
+    tracked(const tracked &other) : value(other.value) { move_count.fetch_add(1, memory_order_relaxed); }
+    tracked(tracked &&other) noexcept : value(std::move(other.value)) { move_count.fetch_add(1, memory_order_relaxed); }
+    tracked &operator=(const tracked &other) {
+        value = other.value;
+        move_count.fetch_add(1, memory_order_relaxed);
+        return *this;
+    }
+    tracked &operator=(tracked &&other) noexcept {
+        value = std::move(other.value);
+        move_count.fetch_add(1, memory_order_relaxed);
+        return *this;
+    }
+};
+
+//comparator of the counting run
+template<typename T>
+struct counting_less {
+    bool operator()(const tracked<T> &a, const tracked<T> &b) const {
+        comparison_count.fetch_add(1, memory_order_relaxed);
+        return a.value < b.value;
+    }
+};
+
+//map a non negative key to each element type, keeping the order of the keys
+template<typename T> T make_element(int64_t key);
+
+template<> int make_element<int>(int64_t key) { return (int)key; }
+
+template<> double make_element<double>(int64_t key) { return (double)key * 0.5; }
+
+template<> string make_element<string>(int64_t key) {
+    string digits = to_string(key);
+    return "key-" + string(20 - digits.size(), '0') + digits; //zero padded, so string order is key order
+}
+
+template<> record64 make_element<record64>(int64_t key) {
+    record64 record;
+    record.key = key;
+    memset(record.payload, (int)(key & 0x7f), sizeof(record.payload));
+    return record;
+}
+
+const vector<string> DISTRIBUTIONS = {"random", "sorted", "reversed", "organ_pipe", "few_unique", "sawtooth", "all_equal"};
+
+//keys of the given distribution, all in [0, 2^31)
+vector<int64_t> make_keys(const string &distribution, size_t n, mt19937_64 &rng) {
+    vector<int64_t> keys(n);
+    for (size_t i = 0; i < n; i ++) {
+        int64_t k = (int64_t)i;
+        if (distribution == "random") keys[i] = (int64_t)(rng() % (1ull << 31));
+        else if (distribution == "sorted") keys[i] = k;
+        else if (distribution == "reversed") keys[i] = (int64_t)n - k;
+        else if (distribution == "organ_pipe") keys[i] = i < n / 2 ? k : (int64_t)n - k;
+        else if (distribution == "few_unique") keys[i] = (int64_t)(rng() % 16);
+        else if (distribution == "sawtooth") keys[i] = k % (int64_t)max<size_t>(1, n / 16);
+        else keys[i] = 42;
+    }
+    return keys;
+}
+
+struct algorithm_info {
+    string name;
+    bool quadratic; //O(n^2) on some inputs: only run up to QUADRATIC_LIMIT elements
+};
+
+//inputs above this size are skipped for quadratic algorithms
+const size_t QUADRATIC_LIMIT = 10000;
+
+//number of elements selected by partial_sort and top_k
+const size_t SELECT_K = 100;
+
+const vector<algorithm_info> ALGORITHMS = {
+    {"bubble_sort", true},
+    {"insertion_sort", true},
+    {"selection_sort", true},
+    {"merge_sort", false},
+    {"quick_sort_inplace", true},
+    {"quick_sort_extra", true},
+    {"heap_sort", false},
+    {"quick_sort_intro", false},
+    {"quick_sort_block", false},
+    {"quick_sort_3way", false},
+    {"quick_sort_extra_3way", false},
+    {"merge_sort_buffered", false},
+    {"merge_sort_adaptive", false},
+    {"merge_sort_inplace", false},
+    {"merge_sort_parallel", false},
+    {"quick_sort_parallel", false},
+    {"sample_sort", false},
+    {"radix_sort", false},
+    {"string_sort", false},
+    {"sort", false},
+    {"partial_sort_k100", false},
+    {"top_k_100", false},
+    {"quick_select_median", false},
+};
+
+//run the named algorithm, return false if it does not apply to T and Compare
+template<typename T, typename Compare>
+bool run_sort(const string &name, vector<T> &arr, Compare comp) {
+    if (name == "bubble_sort") bubble_sort(arr, comp);
+    else if (name == "insertion_sort") insertion_sort(arr, comp);
+    else if (name == "selection_sort") selection_sort(arr, comp);
+    else if (name == "merge_sort") merge_sort(arr, comp);
+    else if (name == "quick_sort_inplace") quick_sort_inplace(arr, comp);
+    else if (name == "quick_sort_extra") quick_sort_extra(arr, comp);
+    else if (name == "heap_sort") heap_sort(arr, comp);
+    else if (name == "quick_sort_intro") quick_sort_intro(arr, comp);
+    else if (name == "quick_sort_block") quick_sort_block(arr, comp);
+    else if (name == "quick_sort_3way") quick_sort_3way(arr, comp);
+    else if (name == "quick_sort_extra_3way") quick_sort_extra_3way(arr, comp);
+    else if (name == "merge_sort_buffered") merge_sort_buffered(arr, comp);
+    else if (name == "merge_sort_adaptive") merge_sort_adaptive(arr, comp);
+    else if (name == "merge_sort_inplace") merge_sort_inplace(arr, comp);
+    else if (name == "merge_sort_parallel") merge_sort_parallel(arr, comp);
+    else if (name == "quick_sort_parallel") quick_sort_parallel(arr, comp);
+    else if (name == "sample_sort") sample_sort(arr, comp);
+    else if (name == "radix_sort") {
+        if constexpr (is_radix_sortable<T>::value && is_natural_less<T, Compare>::value) radix_sort(arr, comp);
+        else return false;
+    }
+    else if (name == "string_sort") {
+        if constexpr (is_string_sortable<T>::value && is_natural_less<T, Compare>::value) string_sort(arr);
+        else return false;
+    }
+    else if (name == "sort") sort(arr, comp);
+    else if (name == "partial_sort_k100") partial_sort(arr, SELECT_K, comp);
+    else if (name == "top_k_100") arr = top_k(arr.begin(), arr.end(), SELECT_K, comp);
+    else if (name == "quick_select_median") quick_select(arr, arr.size() / 2, comp);
+    else return false;
+    return true;
+}
+
+//check the output of the named algorithm against the sorted input:
+//partial_sort must sort the SELECT_K first elements, top_k must return them,
+//quick_select must place the median, and every other algorithm must sort everything
+template<typename T>
+bool check_result(const string &name, const vector<T> &sorted, const vector<T> &arr) {
+    size_t k = min(SELECT_K, sorted.size());
+    if (name == "partial_sort_k100") return equal(sorted.begin(), sorted.begin() + (ptrdiff_t)k, arr.begin());
+    if (name == "top_k_100") return arr == vector<T>(sorted.begin(), sorted.begin() + (ptrdiff_t)k);
+    if (name == "quick_select_median") return sorted.empty() || arr[arr.size() / 2] == sorted[sorted.size() / 2];
+    return arr == sorted;
+}
+
+//time one algorithm on one input and print its CSV row
+template<typename T>
+void bench(const algorithm_info &algorithm, const string &type, const string &distribution, const vector<int64_t> &keys) {
+    size_t n = keys.size();
+    vector<T> input(n);
+    for (size_t i = 0; i < n; i ++) input[i] = make_element<T>(keys[i]);
+    vector<T> sorted = input;
+    std::sort(sorted.begin(), sorted.end());
+
+    //timing run: repeat fast inputs until about 50 ms were measured, up to 10^6 sorted elements
+    size_t max_repeats = max<size_t>(1, 1000000 / max<size_t>(n, 1));
+    size_t repeats = 0;
+    double total_ns = 0;
+    size_t allocations = 0;
+    long long misses = 0;
+    perf_counter branch_misses(perf_event::branch_misses);
+    while (repeats < max_repeats && total_ns < 5e7) {
+        repeats ++;
+        vector<T> arr = input;
+
+        allocation_count = 0;
+        branch_misses.start();
+        auto start = chrono::steady_clock::now();
+        bool applies = run_sort(algorithm.name, arr, less<T>());
+        auto end = chrono::steady_clock::now();
+        long long m = branch_misses.stop();
+        if (!applies) return;
+
+        total_ns += chrono::duration<double, nano>(end - start).count();
+        allocations += allocation_count;
+        misses = (m < 0 || misses < 0) ? -1 : misses + m;
+        if (!check_result(algorithm.name, sorted, arr)) {
+            cerr << algorithm.name << " failed on " << type << " " << distribution << " n=" << n << endl;
+        }
+    }
+
+    //counting run on tracked elements with a counting comparator
+    string comparisons = "", moves = "";
+    vector<tracked<T>> counted(n);
+    for (size_t i = 0; i < n; i ++) counted[i].value = input[i];
+    comparison_count = 0;
+    move_count = 0;
+    if (run_sort(algorithm.name, counted, counting_less<T>())) {
+        comparisons = to_string(comparison_count.load());
+        moves = to_string(move_count.load());
+    }
+
+    cout << algorithm.name << ',' << type << ',' << distribution << ',' << n << ','
+         << total_ns / (double)repeats / (double)max<size_t>(n, 1) << ','
+         << comparisons << ',' << moves << ','
+         << (double)allocations / (double)repeats << ',';
+    if (misses >= 0) cout << (double)misses / (double)repeats;
+    cout << endl;
+}
+
+int main(int argc, char *argv[]) {
+    size_t max_n = argc > 1 ? (size_t)strtoull(argv[1], nullptr, 10) : 1000000;
+    max_n = min<size_t>(max_n, 100000000);
+    string filter = argc > 2 ? argv[2] : "";
+
+    mt19937_64 rng(281);
+    cout << "algorithm,type,distribution,n,ns_per_element,comparisons,moves,allocations,branch_misses" << endl;
+
+    for (size_t n = 10; n <= max_n; n *= 10) {
+        for (const string &distribution:DISTRIBUTIONS) {
+            vector<int64_t> keys = make_keys(distribution, n, rng);
+            for (const algorithm_info &algorithm:ALGORITHMS) {
+                if (algorithm.name.find(filter) == string::npos) continue;
+                if (algorithm.quadratic && n > QUADRATIC_LIMIT) continue;
+
+                bench<int>(algorithm, "int", distribution, keys);
+                bench<double>(algorithm, "double", distribution, keys);
+                bench<string>(algorithm, "string", distribution, keys);
+                bench<record64>(algorithm, "record64", distribution, keys);
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,1118 @@
+#ifndef VE281P1_HULL_HPP
+#define VE281P1_HULL_HPP
+
+
+#include <map>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <utility>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include <array>
+#include "sort.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+struct Point {
+    long int x; //x-coordinate of the point
+    long int y; //y-coordinate of the point
+    double polar_angle; //the polar angle with lowest point
+    long double distance; //the distance from between the point to lowest point
+    bool lowest_point; //return true if it is the lowest point
+};
+
+//point with only its coordinates set
+inline Point make_point(long int x, long int y) {
+    Point P;
+    P.x = x;
+    P.y = y;
+    P.polar_angle = 0;
+    P.distance = 0;
+    P.lowest_point = false;
+    return P;
+}
+
+//cross product of P_1 -> P_2 and P_1 -> P_3
+//positive if P_1, P_2, P_3 turn counterclockwise, negative if clockwise, 0 if they are collinear
+inline double ccw(const Point &P_1, const Point &P_2, const Point &P_3){
+    return ((double)P_2.x - (double)P_1.x)*((double)P_3.y - (double)P_1.y) - ((double)P_2.y - (double)P_1.y)*((double)P_3.x - (double)P_1.x);
+}
+
+//integer wide enough for differences of long int coordinates, which are below 2^64 in magnitude;
+//their products reach 2^128 and overflow it, so the exact predicates compare them with wide_cross_sign
+#if defined(__SIZEOF_INT128__)
+typedef __int128 wide_int;
+
+//sign of ax * by - ay * bx for differences of long int coordinates, without overflow: the two products are
+//compared by their signs and then by their magnitudes, which fit an unsigned 128 bit integer
+inline int wide_cross_sign(wide_int ax, wide_int ay, wide_int bx, wide_int by) {
+    auto sign = [](wide_int a) { return (a > 0) - (a < 0); };
+    auto magnitude = [](wide_int a) { return (unsigned __int128)(a < 0 ? -a : a); };
+
+    int left = sign(ax) * sign(by), right = sign(ay) * sign(bx);
+    if (left != right) return left > right ? 1 : -1;
+    if (left == 0) return 0;
+
+    unsigned __int128 p = magnitude(ax) * magnitude(by), q = magnitude(ay) * magnitude(bx);
+    if (p == q) return 0;
+    return (p > q) == (left > 0) ? 1 : -1;
+}
+#else
+typedef long double wide_int; //no 128 bit integer: exact up to 2^64 only
+
+inline int wide_cross_sign(wide_int ax, wide_int ay, wide_int bx, wide_int by) {
+    wide_int cross = ax * by - ay * bx;
+    return (cross > 0) - (cross < 0);
+}
+#endif
+
+//exact sign of ccw(P_1, P_2, P_3): 1 if P_1, P_2, P_3 turn counterclockwise, -1 if clockwise, 0 if they are collinear
+inline int ccw_sign(const Point &P_1, const Point &P_2, const Point &P_3) {
+    return wide_cross_sign((wide_int)P_2.x - P_1.x, (wide_int)P_2.y - P_1.y, (wide_int)P_3.x - P_1.x, (wide_int)P_3.y - P_1.y);
+}
+
+
+//structure of arrays
+//points stored as two coordinate arrays, 16 bytes per point instead of the 48 of a Point:
+//scans over many points only stream the coordinates, four of them per AVX2 register
+struct point_arrays {
+    std::vector<long int> x;
+    std::vector<long int> y;
+
+    std::size_t size() const { return x.size(); }
+
+    bool empty() const { return x.empty(); }
+
+    void reserve(std::size_t n) {
+        x.reserve(n);
+        y.reserve(n);
+    }
+
+    void push_back(long int px, long int py) {
+        x.push_back(px);
+        y.push_back(py);
+    }
+};
+
+//the coordinates of the points as arrays
+inline point_arrays make_point_arrays(const std::vector<Point> &points) {
+    point_arrays arrays;
+    arrays.reserve(points.size());
+    for (const auto &el:points) arrays.push_back(el.x, el.y);
+    return arrays;
+}
+
+//coordinates of point i of a vector of Point (or of any struct with x and y) or of point_arrays,
+//so the exact hull algorithms below run on either storage
+template<typename P>
+inline long int point_x(const std::vector<P> &points, std::size_t i) { return points[i].x; }
+
+template<typename P>
+inline long int point_y(const std::vector<P> &points, std::size_t i) { return points[i].y; }
+
+inline long int point_x(const point_arrays &points, std::size_t i) { return points.x[i]; }
+
+inline long int point_y(const point_arrays &points, std::size_t i) { return points.y[i]; }
+
+#if defined(__AVX2__)
+//structure of arrays helper function
+//AVX2 has no 64 bit min, max or multiply: these are a compare and a blend, and a multiply of the low 32 bits
+inline __m256i simd_load64(const long int *ptr) { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr)); }
+inline __m256i simd_min64(__m256i a, __m256i b) { return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b)); }
+inline __m256i simd_max64(__m256i a, __m256i b) { return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b)); }
+
+//structure of arrays helper function
+//the four 64 bit lanes of v
+inline void simd_lanes64(__m256i v, long int (&lanes)[4]) { _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), v); }
+#endif
+
+
+//graham scan
+//graham scan helper function
+//polar angle of point around P_0 in degrees
+inline double polar_angle(Point P_0, Point point) {
+    long int y = point.y - P_0.y;
+    long int x = point.x - P_0.x;
+
+    double rad = atan2(y, x); //calculated polar angle in radius
+
+    return rad * (180 / M_PI);
+}
+
+inline bool compare_polar_angle(const Point &P_0,const Point &P_1) {
+    return P_0.polar_angle < P_1.polar_angle;
+}
+
+//graham scan helper function
+//index of the lowest point, the leftmost one on ties and the first one read among equal points
+inline std::size_t lowest_point_index(const std::vector<Point> &points) {
+    std::size_t index = 0;
+    for (std::size_t i = 1; i < points.size(); i ++) {
+        if (points[i].y < points[index].y || (points[i].y == points[index].y && points[i].x < points[index].x)) index = i;
+    }
+    return index;
+}
+
+//graham scan helper function
+//index of the lowest point of the arrays, the leftmost one on ties and the first one among equal points:
+//every AVX2 lane keeps the best point of its quarter of the input and the lanes are compared at the end
+inline std::size_t lowest_point_index(const point_arrays &points) {
+    std::size_t n = points.size(), i = 0, index = 0;
+    if (n == 0) return 0;
+
+#if defined(__AVX2__)
+    if (n >= 8) {
+        __m256i best_x = simd_load64(&points.x[0]), best_y = simd_load64(&points.y[0]);
+        __m256i best_i = _mm256_setr_epi64x(0, 1, 2, 3), ids = best_i;
+        const __m256i four = _mm256_set1_epi64x(4);
+        for (i = 4; i + 4 <= n; i += 4) {
+            ids = _mm256_add_epi64(ids, four);
+            __m256i x = simd_load64(&points.x[i]), y = simd_load64(&points.y[i]);
+            __m256i lower = _mm256_cmpgt_epi64(best_y, y);
+            __m256i lefter = _mm256_and_si256(_mm256_cmpeq_epi64(best_y, y), _mm256_cmpgt_epi64(best_x, x));
+            __m256i better = _mm256_or_si256(lower, lefter);
+            best_x = _mm256_blendv_epi8(best_x, x, better);
+            best_y = _mm256_blendv_epi8(best_y, y, better);
+            best_i = _mm256_blendv_epi8(best_i, ids, better);
+        }
+
+        long int lane_x[4], lane_y[4], lane_i[4];
+        simd_lanes64(best_x, lane_x);
+        simd_lanes64(best_y, lane_y);
+        simd_lanes64(best_i, lane_i);
+        index = (std::size_t)lane_i[0];
+        for (std::size_t k = 1; k < 4; k ++) {
+            std::size_t j = (std::size_t)lane_i[k];
+            if (lane_y[k] < points.y[index] || (lane_y[k] == points.y[index] && (lane_x[k] < points.x[index] ||
+                                                                                  (lane_x[k] == points.x[index] && j < index)))) index = j;
+        }
+    }
+#endif
+
+    for (; i < n; i ++) {
+        if (points.y[i] < points.y[index] || (points.y[i] == points.y[index] && points.x[i] < points.x[index])) index = i;
+    }
+    return index;
+}
+
+//convex hull by graham scan over the polar angles around the lowest point P_0:
+//counterclockwise from P_0, without collinear points
+inline std::vector<Point> graham_scan(std::vector<Point> points) {
+    std::vector<Point> stack; //stack to store the convex hull
+    if (points.empty()) return stack;
+
+    unsigned long int index = lowest_point_index(points); //index in the array of the lowest coordinate point
+    for (auto &el:points) el.lowest_point = false;
+    points[index].lowest_point = true; //indicate the points is lowest points
+    Point P_0 = points[index]; //lowest coordinate point
+
+    //calculate the polar angle of the all the points 
+    //calculate the distance from the point to the lowest point
+    for (auto &el:points) {
+        el.polar_angle = polar_angle(P_0, el);
+        el.distance = sqrt(pow(el.x - P_0.x, 2) + pow(el.y - P_0.y, 2));
+    }
+
+    //if P_0 is not at first index, swap the P_0 with the element at the first index
+    if (index != 0) {
+        std::swap(points[index], points[0]);
+    } 
+
+    //sort the array base on polar angle compared to the lowest point coordinate
+    //sort from smallest to largest angle
+    std::sort(points.begin() + 1, points.end(), compare_polar_angle);
+
+    //remove element that has same coordinate as P_0
+    for (unsigned long int i = 1; i < points.size(); ) {
+        if (points[i].x == P_0.x && points[i].y == P_0.y) {
+            //remove the points with the same coordinate as P_0
+            points.erase(points.begin() + (long int)i);
+        }
+        else {
+            i ++;
+        }
+    }
+
+    //remove points that are have the same polar angle and only keep the point that has furthest distance from lowest point 
+    for (int i = 1; i < (int)points.size() - 1; ) {
+        //start from index 1 to skip out the first element (P_0)
+        if (points[(unsigned long int)i].polar_angle == points[(unsigned long int)i + 1].polar_angle) {
+            //remove the points that have same polar angle that are not the furthest 
+            if (points[(unsigned long int)i].distance < points[(unsigned long int)i + 1].distance) {
+                points.erase(points.begin() + (long int)i);
+            }
+            else {
+                points.erase(points.begin() + (long int)i + 1);
+            }
+        }
+        else {
+            i ++;
+        }
+    }
+
+    //graham scan 
+    for (auto &el:points) {
+        while (stack.size() > 1 && (ccw(stack[stack.size() - 2], stack.back(), el) <= 0)) {
+            stack.pop_back(); //pop the last element from the stack
+        }
+        stack.push_back(el);
+    }
+    return stack;
+}
+
+//exact graham scan helper struct
+//a point as its offset from P_0, the only data the exact graham scan sorts and moves
+template<typename Int>
+struct point_offset {
+    Int dx;
+    Int dy;
+};
+
+//exact graham scan helper function
+//sign of the cross product of (ax, ay) and (bx, by), differences of coordinates
+//in long int when their products fit it, and in wide_int without forming the products otherwise
+template<typename Int>
+inline int cross_sign(Int ax, Int ay, Int bx, Int by) {
+    Int cross = ax * by - ay * bx;
+    return (cross > 0) - (cross < 0);
+}
+
+template<>
+inline int cross_sign<wide_int>(wide_int ax, wide_int ay, wide_int bx, wide_int by) {
+    return wide_cross_sign(ax, ay, bx, by);
+}
+
+//exact graham scan helper function
+//graham scan over the offsets of the points (a vector of Point or point_arrays) from P_0 in Int arithmetic,
+//which is long int when the products of offset differences fit it, wide_int otherwise
+template<typename Int, typename Points>
+std::vector<Point> graham_scan_offsets(const Points &points, const Point &P_0) {
+    typedef point_offset<Int> Offset;
+    std::vector<Offset> offsets;
+    offsets.reserve(points.size());
+    for (std::size_t i = 0; i < points.size(); i ++) {
+        long int x = point_x(points, i), y = point_y(points, i);
+        if (x == P_0.x && y == P_0.y) continue; //P_0 and its duplicates
+        offsets.push_back(Offset{(Int)x - (Int)P_0.x, (Int)y - (Int)P_0.y});
+    }
+
+    //P_0 is the lowest point, so every offset lies at an angle in [0, 180) degrees and a comes before b
+    //exactly when a turns counterclockwise to b; on the same ray the nearer point, with the smaller L1 norm, comes first
+    std::sort(offsets.begin(), offsets.end(), [](const Offset &a, const Offset &b) {
+        int turn = cross_sign(a.dx, a.dy, b.dx, b.dy);
+        if (turn != 0) return turn > 0;
+        return (a.dx < 0 ? -a.dx : a.dx) + a.dy < (b.dx < 0 ? -b.dx : b.dx) + b.dy;
+    });
+
+    //keep the farthest point of every ray, the last of its run
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < offsets.size(); i ++) {
+        if (i + 1 < offsets.size() && cross_sign(offsets[i].dx, offsets[i].dy, offsets[i + 1].dx, offsets[i + 1].dy) == 0) continue;
+        offsets[kept ++] = offsets[i];
+    }
+    offsets.resize(kept);
+
+    std::vector<Offset> stack(1, Offset{0, 0}); //P_0
+    for (const auto &el:offsets) {
+        while (stack.size() > 1) {
+            const Offset &a = stack[stack.size() - 2], &b = stack.back();
+            if (cross_sign(b.dx - a.dx, b.dy - a.dy, el.dx - a.dx, el.dy - a.dy) > 0) break;
+            stack.pop_back();
+        }
+        stack.push_back(el);
+    }
+
+    std::vector<Point> hull;
+    hull.reserve(stack.size());
+    for (const auto &el:stack) hull.push_back(make_point((long int)(P_0.x + el.dx), (long int)(P_0.y + el.dy)));
+    return hull;
+}
+
+//graham scan with the same output as graham_scan, without trigonometry, square roots or floating point:
+//the points are sorted by exact cross products of their offsets from P_0, so collinear points are never misordered
+//however large the coordinates, and the duplicates of P_0 and the nearer points on shared rays are dropped by
+//compacting in a single pass; offsets below 2^30 use 64 bit products, larger ones 128 bit products
+//points is a vector of Point or point_arrays
+template<typename Points>
+std::vector<Point> graham_scan_exact(const Points &points) {
+    if (points.empty()) return std::vector<Point>();
+
+    std::size_t lowest = lowest_point_index(points);
+    Point P_0 = make_point(point_x(points, lowest), point_y(points, lowest));
+    wide_int max_offset = 0;
+    for (std::size_t i = 0; i < points.size(); i ++) {
+        wide_int dx = (wide_int)point_x(points, i) - P_0.x;
+        max_offset = std::max(max_offset, std::max(dx < 0 ? -dx : dx, (wide_int)point_y(points, i) - P_0.y));
+    }
+
+    if (max_offset < (wide_int)(1l << 30)) return graham_scan_offsets<long int>(points, P_0);
+    return graham_scan_offsets<wide_int>(points, P_0);
+}
+
+
+//monotone chain
+//monotone chain helper struct
+//the coordinates of a point, the only data the monotone chain sorts and moves
+struct point_coordinates {
+    long int x;
+    long int y;
+};
+
+//monotone chain helper struct
+//the smallest axis aligned box around a set of points
+struct bounding_box {
+    long int min_x;
+    long int max_x;
+    long int min_y;
+    long int max_y;
+
+    std::uint64_t width() const { return (std::uint64_t)max_x - (std::uint64_t)min_x; }
+
+    std::uint64_t height() const { return (std::uint64_t)max_y - (std::uint64_t)min_y; }
+
+    //true if cross products of coordinate differences within the box fit in 64 bits
+    bool fits_long_products() const { return std::max(width(), height()) < (std::uint64_t(1) << 30); }
+};
+
+//monotone chain helper function
+//bounding box of the points[first, last) (a vector of Point or point_coordinates, or point_arrays), which must not be empty
+template<typename Points>
+bounding_box bounding_box_of(const Points &points, std::size_t first, std::size_t last) {
+    bounding_box box{point_x(points, first), point_x(points, first), point_y(points, first), point_y(points, first)};
+    std::size_t i = first + 1;
+
+#if defined(__AVX2__)
+    if constexpr (std::is_same<Points, point_arrays>::value) {
+        if (last - first >= 8) {
+            __m256i min_x = simd_load64(&points.x[first]), max_x = min_x;
+            __m256i min_y = simd_load64(&points.y[first]), max_y = min_y;
+            for (i = first + 4; i + 4 <= last; i += 4) {
+                __m256i x = simd_load64(&points.x[i]), y = simd_load64(&points.y[i]);
+                min_x = simd_min64(min_x, x);
+                max_x = simd_max64(max_x, x);
+                min_y = simd_min64(min_y, y);
+                max_y = simd_max64(max_y, y);
+            }
+
+            long int lanes[4][4];
+            simd_lanes64(min_x, lanes[0]);
+            simd_lanes64(max_x, lanes[1]);
+            simd_lanes64(min_y, lanes[2]);
+            simd_lanes64(max_y, lanes[3]);
+            for (std::size_t k = 0; k < 4; k ++) {
+                box.min_x = std::min(box.min_x, lanes[0][k]);
+                box.max_x = std::max(box.max_x, lanes[1][k]);
+                box.min_y = std::min(box.min_y, lanes[2][k]);
+                box.max_y = std::max(box.max_y, lanes[3][k]);
+            }
+        }
+    }
+#endif
+
+    for (; i < last; i ++) {
+        box.min_x = std::min(box.min_x, point_x(points, i));
+        box.max_x = std::max(box.max_x, point_x(points, i));
+        box.min_y = std::min(box.min_y, point_y(points, i));
+        box.max_y = std::max(box.max_y, point_y(points, i));
+    }
+    return box;
+}
+
+//monotone chain helper function
+//the distinct points (a vector of Point or point_coordinates, or point_arrays) sorted by x, then y, radix sorted by
+//their offsets from the bottom left corner of a bounding box around them: both offsets packed into one 64 bit key
+//when they fit in 32 bits, otherwise a stable pass by y then one by x; equal points end up next to each other and
+//are compacted in one pass
+template<typename Points>
+std::vector<point_coordinates> sorted_distinct_points(const Points &points, const bounding_box &box) {
+    std::uint64_t min_x = (std::uint64_t)box.min_x, min_y = (std::uint64_t)box.min_y;
+    std::vector<point_coordinates> sorted;
+    if ((box.width() >> 32) == 0 && (box.height() >> 32) == 0) {
+        std::vector<std::uint64_t> keys(points.size());
+        for (std::size_t i = 0; i < points.size(); i ++) {
+            std::uint64_t dx = (std::uint64_t)point_x(points, i) - min_x;
+            std::uint64_t dy = (std::uint64_t)point_y(points, i) - min_y;
+            keys[i] = dx << 32 | dy;
+        }
+        radix_sort(keys, std::less<std::uint64_t>());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+        sorted.resize(keys.size());
+        for (std::size_t i = 0; i < keys.size(); i ++) {
+            sorted[i].x = (long int)(min_x + (keys[i] >> 32));
+            sorted[i].y = (long int)(min_y + (keys[i] & 0xffffffffu));
+        }
+        return sorted;
+    }
+
+    sorted.resize(points.size());
+    for (std::size_t i = 0; i < points.size(); i ++) sorted[i] = point_coordinates{point_x(points, i), point_y(points, i)};
+    lsd_radix_sort(sorted, [min_y](const point_coordinates &el) { return (std::uint64_t)el.y - min_y; });
+    lsd_radix_sort(sorted, [min_x](const point_coordinates &el) { return (std::uint64_t)el.x - min_x; });
+    sorted.erase(std::unique(sorted.begin(), sorted.end(), [](const point_coordinates &a, const point_coordinates &b) {
+        return a.x == b.x && a.y == b.y;
+    }), sorted.end());
+    return sorted;
+}
+
+//monotone chain helper function
+//append the sorted points [first, last) to chain as one half of the hull, popping every vertex that does not turn
+//counterclockwise but never the one at index base; Int is long int when the products of coordinate differences
+//fit it, wide_int otherwise
+template<typename Int, typename It>
+void monotone_chain_half(It first, It last, std::vector<point_coordinates> &chain, std::size_t base) {
+    for (; first != last; first ++) {
+        const point_coordinates &P = *first;
+        while (chain.size() > base + 1) {
+            const point_coordinates &a = chain[chain.size() - 2], &b = chain.back();
+            if (cross_sign<Int>((Int)b.x - a.x, (Int)b.y - a.y, (Int)P.x - a.x, (Int)P.y - a.y) > 0) break;
+            chain.pop_back();
+        }
+        chain.push_back(P);
+    }
+}
+
+//monotone chain helper function
+//append the hull vertices of the sorted distinct points [first, last) to chain, counterclockwise from the first one:
+//the lower half left to right, then the upper half right to left starting from the rightmost point
+template<typename Int, typename It>
+void append_monotone_chain(It first, It last, std::vector<point_coordinates> &chain) {
+    if (last - first < 2) {
+        chain.insert(chain.end(), first, last);
+        return;
+    }
+
+    monotone_chain_half<Int>(first, last, chain, chain.size());
+    monotone_chain_half<Int>(std::make_reverse_iterator(last) + 1, std::make_reverse_iterator(first), chain, chain.size() - 1);
+    chain.pop_back(); //the leftmost point closes the upper half
+}
+
+//monotone chain helper function
+//hull vertices of the sorted distinct points counterclockwise from the first one
+template<typename Int>
+std::vector<point_coordinates> monotone_chain_vertices(const std::vector<point_coordinates> &sorted) {
+    std::vector<point_coordinates> chain;
+    append_monotone_chain<Int>(sorted.begin(), sorted.end(), chain);
+    return chain;
+}
+
+//monotone chain helper function
+//hull vertices of the points (a vector of Point or point_coordinates, or point_arrays) counterclockwise from the
+//leftmost point, the lowest one on ties
+template<typename Points>
+std::vector<point_coordinates> monotone_chain_coordinates(const Points &points) {
+    if (points.empty()) return std::vector<point_coordinates>();
+
+    bounding_box box = bounding_box_of(points, 0, points.size());
+    std::vector<point_coordinates> sorted = sorted_distinct_points(points, box);
+    if (box.fits_long_products()) return monotone_chain_vertices<long int>(sorted);
+    return monotone_chain_vertices<wide_int>(sorted);
+}
+
+//monotone chain helper function
+//hull vertices counterclockwise as points, rotated to start from the lowest point (the leftmost one on ties)
+inline std::vector<Point> hull_from_lowest(const std::vector<point_coordinates> &chain) {
+    std::vector<Point> hull;
+    hull.reserve(chain.size());
+    for (const auto &el:chain) hull.push_back(make_point(el.x, el.y));
+    std::rotate(hull.begin(), hull.begin() + (std::ptrdiff_t)lowest_point_index(hull), hull.end());
+    return hull;
+}
+
+//convex hull by andrew's monotone chain with the same output as graham_scan: counterclockwise from the lowest point
+//(the leftmost one on ties) and without collinear points. The points are radix sorted by x, then y and deduplicated
+//in a single pass, and each half of the hull is one stack pass over them, so duplicated and collinear points cost O(1)
+//each instead of an erase; spans below 2^30 use 64 bit cross products, larger ones 128 bit products
+//points is a vector of Point or point_arrays
+template<typename Points>
+std::vector<Point> monotone_chain(const Points &points) {
+    return hull_from_lowest(monotone_chain_coordinates(points));
+}
+
+//parallel convex hull
+//the points a thread keeps after filtering are reduced to their hull whenever this many, or twice the
+//size of that hull, have piled up, so a thread holds O(block + hull) points however many pass the filter
+constexpr std::size_t PARALLEL_HULL_BLOCK = 1 << 16;
+
+//parallel hull helper function
+//scores of a point in the eight directions of the akl-toussaint octagon, from its offsets (u, v) from the bottom left
+//corner of the bounding box: -y, x - y, x, x + y, y, y - x, -x, -x - y, whose outward normals turn counterclockwise,
+//so the points of highest score are the vertices of a convex octagon inscribed in the hull, counterclockwise
+template<typename Int>
+inline void octagon_scores(Int u, Int v, Int (&score)[8]) {
+    score[0] = -v;
+    score[1] = u - v;
+    score[2] = u;
+    score[3] = u + v;
+    score[4] = v;
+    score[5] = v - u;
+    score[6] = -u;
+    score[7] = -u - v;
+}
+
+#if defined(__AVX2__)
+//parallel hull helper function
+//octagon_scores of four points at once
+inline void octagon_scores(__m256i u, __m256i v, __m256i (&score)[8]) {
+    const __m256i zero = _mm256_setzero_si256();
+    score[0] = _mm256_sub_epi64(zero, v);
+    score[1] = _mm256_sub_epi64(u, v);
+    score[2] = u;
+    score[3] = _mm256_add_epi64(u, v);
+    score[4] = v;
+    score[5] = _mm256_sub_epi64(v, u);
+    score[6] = _mm256_sub_epi64(zero, u);
+    score[7] = _mm256_sub_epi64(zero, score[3]);
+}
+#endif
+
+//parallel hull helper function
+//index of the point of highest score in each direction of the octagon among points[first, last), which must not be
+//empty; on point_arrays with 64 bit products every AVX2 lane keeps the best of its quarter of the stripe
+template<typename Int, typename Points>
+void stripe_extremes(const Points &points, std::size_t first, std::size_t last, const bounding_box &box, std::size_t (&index)[8]) {
+    Int best[8], score[8];
+    octagon_scores<Int>((Int)point_x(points, first) - box.min_x, (Int)point_y(points, first) - box.min_y, best);
+    for (std::size_t k = 0; k < 8; k ++) index[k] = first;
+    std::size_t i = first + 1;
+
+#if defined(__AVX2__)
+    if constexpr (std::is_same<Points, point_arrays>::value && std::is_same<Int, long int>::value) {
+        if (last - first >= 8) {
+            const __m256i min_x = _mm256_set1_epi64x(box.min_x), min_y = _mm256_set1_epi64x(box.min_y);
+            const __m256i four = _mm256_set1_epi64x(4);
+            __m256i ids = _mm256_setr_epi64x((long long)first, (long long)first + 1, (long long)first + 2, (long long)first + 3);
+            __m256i best_score[8], best_id[8], lane_score[8];
+            octagon_scores(_mm256_sub_epi64(simd_load64(&points.x[first]), min_x),
+                           _mm256_sub_epi64(simd_load64(&points.y[first]), min_y), best_score);
+            for (std::size_t k = 0; k < 8; k ++) best_id[k] = ids;
+
+            for (i = first + 4; i + 4 <= last; i += 4) {
+                ids = _mm256_add_epi64(ids, four);
+                octagon_scores(_mm256_sub_epi64(simd_load64(&points.x[i]), min_x),
+                               _mm256_sub_epi64(simd_load64(&points.y[i]), min_y), lane_score);
+                for (std::size_t k = 0; k < 8; k ++) {
+                    __m256i higher = _mm256_cmpgt_epi64(lane_score[k], best_score[k]);
+                    best_score[k] = _mm256_blendv_epi8(best_score[k], lane_score[k], higher);
+                    best_id[k] = _mm256_blendv_epi8(best_id[k], ids, higher);
+                }
+            }
+
+            //the highest score of the four lanes, the first point on ties
+            for (std::size_t k = 0; k < 8; k ++) {
+                long int lane_best[4], lane_id[4];
+                simd_lanes64(best_score[k], lane_best);
+                simd_lanes64(best_id[k], lane_id);
+                best[k] = lane_best[0];
+                index[k] = (std::size_t)lane_id[0];
+                for (std::size_t j = 1; j < 4; j ++) {
+                    if (lane_best[j] > best[k] || (lane_best[j] == best[k] && (std::size_t)lane_id[j] < index[k])) {
+                        best[k] = lane_best[j];
+                        index[k] = (std::size_t)lane_id[j];
+                    }
+                }
+            }
+        }
+    }
+#endif
+
+    for (; i < last; i ++) {
+        octagon_scores<Int>((Int)point_x(points, i) - box.min_x, (Int)point_y(points, i) - box.min_y, score);
+        for (std::size_t k = 0; k < 8; k ++) {
+            if (score[k] > best[k]) {
+                best[k] = score[k];
+                index[k] = i;
+            }
+        }
+    }
+}
+
+//parallel hull helper struct
+//the akl-toussaint octagon as its edges from (u, v) along (ex, ey), with (u, v) the offsets of a vertex from the bottom
+//left corner of the bounding box: a point is strictly inside the octagon when it is strictly left of every edge
+template<typename Int>
+struct octagon_edges {
+    Int ex[8];
+    Int ey[8];
+    Int u[8];
+    Int v[8];
+};
+
+//parallel hull helper function
+//call keep(i) for every point of points[first, last) that is not strictly inside the octagon:
+//eight cross products per point, on point_arrays with 64 bit products four points at a time with AVX2 as
+//ex * v - ey * u > c, where the products of offsets below 2^30 are multiplies of the low 32 bits
+template<typename Int, typename Points, typename Keep>
+void filter_stripe(const Points &points, std::size_t first, std::size_t last, const bounding_box &box,
+                   const octagon_edges<Int> &octagon, Keep keep) {
+    std::size_t i = first;
+
+#if defined(__AVX2__)
+    if constexpr (std::is_same<Points, point_arrays>::value && std::is_same<Int, long int>::value) {
+        const __m256i min_x = _mm256_set1_epi64x(box.min_x), min_y = _mm256_set1_epi64x(box.min_y);
+        __m256i ex[8], ey[8], c[8];
+        for (std::size_t k = 0; k < 8; k ++) {
+            ex[k] = _mm256_set1_epi64x(octagon.ex[k]);
+            ey[k] = _mm256_set1_epi64x(octagon.ey[k]);
+            c[k] = _mm256_set1_epi64x(octagon.ex[k] * octagon.v[k] - octagon.ey[k] * octagon.u[k]);
+        }
+        for (; i + 4 <= last; i += 4) {
+            __m256i u = _mm256_sub_epi64(simd_load64(&points.x[i]), min_x);
+            __m256i v = _mm256_sub_epi64(simd_load64(&points.y[i]), min_y);
+            __m256i inside = _mm256_set1_epi64x(-1);
+            for (std::size_t k = 0; k < 8; k ++) {
+                __m256i cross = _mm256_sub_epi64(_mm256_mul_epi32(ex[k], v), _mm256_mul_epi32(ey[k], u));
+                inside = _mm256_and_si256(inside, _mm256_cmpgt_epi64(cross, c[k]));
+            }
+            int outside = ~_mm256_movemask_pd(_mm256_castsi256_pd(inside)) & 0xf;
+            for (std::size_t j = 0; outside != 0; j ++, outside >>= 1) {
+                if (outside & 1) keep(i + j);
+            }
+        }
+    }
+#endif
+
+    for (; i < last; i ++) {
+        Int u = (Int)point_x(points, i) - box.min_x, v = (Int)point_y(points, i) - box.min_y;
+        bool inside = true;
+        for (std::size_t k = 0; k < 8; k ++) inside &= cross_sign<Int>(octagon.ex[k], octagon.ey[k], u - octagon.u[k], v - octagon.v[k]) > 0;
+        if (!inside) keep(i);
+    }
+}
+
+//parallel hull helper function
+//hull of the points (a vector of Point or point_arrays) on `threads` threads, counterclockwise from the leftmost point:
+//every thread finds the octagon vertices of its stripe, then drops the points of its stripe strictly inside the
+//octagon of the whole set and builds the monotone chain hull of the rest; the local hulls are merged by one more
+//monotone chain over their vertices. Int is long int when the products of coordinate differences within box
+//fit it, wide_int otherwise
+template<typename Int, typename Points>
+std::vector<point_coordinates> parallel_hull_coordinates(const Points &points, const bounding_box &box, std::size_t threads) {
+    std::size_t n = points.size();
+
+    //extreme points of every stripe, extreme[t][k] is the index of the highest score k in stripe t
+    std::vector<std::array<std::size_t, 8>> extreme(threads);
+    run_on_threads(threads, [&](std::size_t t) {
+        std::size_t index[8];
+        stripe_extremes<Int>(points, n * t / threads, n * (t + 1) / threads, box, index);
+        std::copy(index, index + 8, extreme[t].begin());
+    });
+
+    //octagon vertices as offsets from the corner of the box
+    Int u[8], v[8];
+    for (std::size_t k = 0; k < 8; k ++) {
+        Int best = 0;
+        for (std::size_t t = 0; t < threads; t ++) {
+            std::size_t i = extreme[t][k];
+            Int pu = (Int)point_x(points, i) - box.min_x, pv = (Int)point_y(points, i) - box.min_y, score[8];
+            octagon_scores<Int>(pu, pv, score);
+            if (t == 0 || score[k] > best) {
+                best = score[k];
+                u[k] = pu;
+                v[k] = pv;
+            }
+        }
+    }
+
+    //the edges between repeated vertices are skipped and the free slots repeat the first edge
+    octagon_edges<Int> octagon;
+    std::size_t edges = 0;
+    for (std::size_t k = 0; k < 8; k ++) {
+        std::size_t next = (k + 1) % 8;
+        if (u[k] == u[next] && v[k] == v[next]) continue;
+        octagon.ex[edges] = u[next] - u[k];
+        octagon.ey[edges] = v[next] - v[k];
+        octagon.u[edges] = u[k];
+        octagon.v[edges] = v[k];
+        edges ++;
+    }
+    if (edges == 0) return std::vector<point_coordinates>(1, point_coordinates{point_x(points, 0), point_y(points, 0)}); //all points are equal
+    for (std::size_t k = edges; k < 8; k ++) {
+        octagon.ex[k] = octagon.ex[0];
+        octagon.ey[k] = octagon.ey[0];
+        octagon.u[k] = octagon.u[0];
+        octagon.v[k] = octagon.v[0];
+    }
+
+    std::vector<std::vector<point_coordinates>> local(threads);
+    run_on_threads(threads, [&](std::size_t t) {
+        std::vector<point_coordinates> kept;
+        std::size_t limit = PARALLEL_HULL_BLOCK;
+        filter_stripe<Int>(points, n * t / threads, n * (t + 1) / threads, box, octagon, [&](std::size_t i) {
+            kept.push_back(point_coordinates{point_x(points, i), point_y(points, i)});
+            if (kept.size() >= limit) {
+                kept = monotone_chain_vertices<Int>(sorted_distinct_points(kept, box));
+                limit = std::max(PARALLEL_HULL_BLOCK, 2 * kept.size());
+            }
+        });
+        local[t] = monotone_chain_vertices<Int>(sorted_distinct_points(kept, box));
+    });
+
+    std::vector<point_coordinates> merged;
+    for (const auto &el:local) merged.insert(merged.end(), el.begin(), el.end());
+    return monotone_chain_vertices<Int>(sorted_distinct_points(merged, box));
+}
+
+//convex hull on `threads` threads with the same output as graham_scan, for inputs of hundreds of millions of points:
+//akl-toussaint filtering drops every point strictly inside the octagon of the extreme points in eight directions,
+//each thread builds the monotone chain hull of what is left of its stripe, and the local hulls are merged by a
+//monotone chain over their vertices; every thread gets at least `grain` points
+//points is a vector of Point or point_arrays, whose scans are vectorized with AVX2
+//the threads are std::thread, so link with -pthread
+template<typename Points>
+std::vector<Point> parallel_hull(const Points &points, std::size_t grain, std::size_t threads) {
+    std::size_t n = points.size();
+    if (n == 0) return std::vector<Point>();
+    threads = std::max<std::size_t>(threads, 1);
+    grain = std::max<std::size_t>(grain, 1);
+    threads = std::min(threads, std::max<std::size_t>(n / grain, 1));
+
+    //bounding box of every stripe
+    std::vector<bounding_box> boxes(threads);
+    run_on_threads(threads, [&](std::size_t t) {
+        boxes[t] = bounding_box_of(points, n * t / threads, n * (t + 1) / threads);
+    });
+    bounding_box box = boxes[0];
+    for (const auto &el:boxes) {
+        box.min_x = std::min(box.min_x, el.min_x);
+        box.max_x = std::max(box.max_x, el.max_x);
+        box.min_y = std::min(box.min_y, el.min_y);
+        box.max_y = std::max(box.max_y, el.max_y);
+    }
+
+    if (box.fits_long_products()) return hull_from_lowest(parallel_hull_coordinates<long int>(points, box, threads));
+    return hull_from_lowest(parallel_hull_coordinates<wide_int>(points, box, threads));
+}
+
+template<typename Points>
+std::vector<Point> parallel_hull(const Points &points) {
+    return parallel_hull(points, PARALLEL_GRAIN_SIZE, default_thread_count());
+}
+
+//chan's algorithm
+//chan's algorithm helper function
+inline bool same_point(const point_coordinates &A, const point_coordinates &B) {
+    return A.x == B.x && A.y == B.y;
+}
+
+//chan's algorithm helper function
+//sign of the cross product of P -> A and P -> B: 1 if B is left of the ray P -> A, -1 if right, 0 on its line
+template<typename Int>
+inline int orientation(const point_coordinates &P, const point_coordinates &A, const point_coordinates &B) {
+    return cross_sign<Int>((Int)A.x - P.x, (Int)A.y - P.y, (Int)B.x - P.x, (Int)B.y - P.y);
+}
+
+//chan's algorithm helper function
+//true if the jarvis march from the hull vertex P wraps to B rather than to A: B is right of the ray P -> A,
+//or on it and farther, so no collinear point is ever taken as a vertex
+template<typename Int>
+inline bool wraps_before(const point_coordinates &P, const point_coordinates &A, const point_coordinates &B) {
+    int turn = orientation<Int>(P, A, B);
+    if (turn != 0) return turn < 0;
+
+    Int ax = (Int)A.x - P.x, ay = (Int)A.y - P.y, bx = (Int)B.x - P.x, by = (Int)B.y - P.y;
+    return (bx < 0 ? -bx : bx) + (by < 0 ? -by : by) > (ax < 0 ? -ax : ax) + (ay < 0 ? -ay : ay);
+}
+
+//chan's algorithm helper function
+//index of the vertex the jarvis march from P wraps to on the strictly convex counterclockwise polygon H[0, k), k >= 3,
+//with P strictly outside it. Seen from P, the angle of the vertices increases along the far side of the polygon,
+//where edge i turns counterclockwise around P (e(i) > 0), and decreases along the near side (e(i) <= 0, 0 on an edge
+//in line with P), and the wanted vertex is the first of the far side. The binary search tells the two runs of equal
+//e(i) apart by the side of the ray P -> H[0] their vertices are on, O(log k)
+template<typename Int>
+std::size_t tangent_index(const point_coordinates &P, const point_coordinates *H, std::size_t k) {
+    auto edge = [P, H, k](std::size_t i) { return orientation<Int>(P, H[i], H[i + 1 == k ? 0 : i + 1]); };
+    int first_edge = edge(0);
+
+    //whether vertex i in [1, k) is the wanted one or comes after it in [1, k)
+    auto at_or_after = [&](std::size_t i) {
+        int e = edge(i), side = orientation<Int>(P, H[0], H[i]);
+        if (first_edge > 0) return e > 0 && side < 0; //H[0] is on the far side, the wanted vertex is in the far side run before it
+        return e > 0 || side > 0 || (side == 0 && first_edge != 0); //H[0] is on the near side, the far side follows it
+    };
+
+    std::size_t lo = 1, hi = k;
+    while (lo < hi) {
+        std::size_t mid = lo + (hi - lo) / 2;
+        if (at_or_after(mid)) hi = mid;
+        else lo = mid + 1;
+    }
+    return lo == k ? 0 : lo;
+}
+
+//chan's algorithm helper struct
+//the hulls of the groups of one round, hull g is vertices[first[g], first[g + 1]) counterclockwise
+struct group_hulls {
+    std::vector<point_coordinates> vertices;
+    std::vector<std::size_t> first{0};
+
+    std::size_t size() const { return first.size() - 1; }
+
+    //add the hull of the sorted distinct points as the next one
+    template<typename Int>
+    void add(const std::vector<point_coordinates> &sorted_points) {
+        append_monotone_chain<Int>(sorted_points.begin(), sorted_points.end(), vertices);
+        first.push_back(vertices.size());
+    }
+};
+
+//chan's algorithm helper function
+//hulls of the groups of m consecutive points
+template<typename Int, typename Points>
+group_hulls point_group_hulls(const Points &points, std::size_t m, const bounding_box &box) {
+    std::size_t n = points.size();
+    group_hulls hulls;
+    hulls.first.reserve((n + m - 1) / m + 1);
+
+    std::vector<point_coordinates> group;
+    group.reserve(m);
+    for (std::size_t lo = 0; lo < n; lo += m) {
+        group.clear();
+        for (std::size_t i = lo; i < std::min(n, lo + m); i ++) group.push_back(point_coordinates{point_x(points, i), point_y(points, i)});
+        hulls.add<Int>(sorted_distinct_points(group, box));
+    }
+    return hulls;
+}
+
+//chan's algorithm helper function
+//hulls of the unions of every ratio consecutive groups of previous: the hull of a union is the hull of the vertices
+//of the hulls in it, so only those are sorted again
+template<typename Int>
+group_hulls merged_group_hulls(const group_hulls &previous, std::size_t ratio, const bounding_box &box) {
+    group_hulls hulls;
+    hulls.first.reserve(previous.size() / ratio + 2);
+
+    std::vector<point_coordinates> group;
+    for (std::size_t lo = 0; lo < previous.size(); lo += ratio) {
+        std::size_t hi = std::min(previous.size(), lo + ratio);
+        group.assign(previous.vertices.begin() + (std::ptrdiff_t)previous.first[lo], previous.vertices.begin() + (std::ptrdiff_t)previous.first[hi]);
+        hulls.add<Int>(sorted_distinct_points(group, box));
+    }
+    return hulls;
+}
+
+//no vertex of a group hull
+const std::size_t NO_VERTEX = (std::size_t)-1;
+
+//chan's algorithm helper function
+//index in hull g of the vertex the jarvis march from the hull vertex P wraps to, or NO_VERTEX if the hull has no point other
+//than P; at is the index of P in the hull, or NO_VERTEX if P is not one of its points
+template<typename Int>
+std::size_t group_candidate(const group_hulls &hulls, std::size_t g, const point_coordinates &P, std::size_t at) {
+    const point_coordinates *H = &hulls.vertices[hulls.first[g]];
+    std::size_t k = hulls.first[g + 1] - hulls.first[g];
+    if (at != NO_VERTEX) return k == 1 ? NO_VERTEX : (at + 1 == k ? 0 : at + 1);
+
+    if (k < 3) {
+        std::size_t best = 0;
+        for (std::size_t i = 1; i < k; i ++) {
+            if (wraps_before<Int>(P, H[best], H[i])) best = i;
+        }
+        return best;
+    }
+    return tangent_index<Int>(P, H, k);
+}
+
+//chan's algorithm helper function
+//continue the jarvis march over the group hulls from the last vertex of hull, wrapping to the best candidate of the
+//groups at every step, until it is back at hull[0] or hull has more than m vertices; return false in the second case
+template<typename Int>
+bool jarvis_march(const group_hulls &hulls, std::size_t m, std::vector<point_coordinates> &hull) {
+    //at[g] is the index of the current vertex in hull g, if it is one of its points: then it is a vertex of that hull
+    //too, and the best candidate of the group at the last step. candidate[g] is the candidate of group g at this step
+    std::size_t groups = hulls.size();
+    std::vector<std::size_t> at(groups, NO_VERTEX), candidate(groups);
+    for (std::size_t g = 0; g < groups; g ++) {
+        for (std::size_t i = hulls.first[g]; i < hulls.first[g + 1]; i ++) {
+            if (same_point(hulls.vertices[i], hull.back())) at[g] = i - hulls.first[g];
+        }
+    }
+
+    while (hull.size() <= m) {
+        point_coordinates P = hull.back(), next = P;
+        bool found = false;
+        for (std::size_t g = 0; g < groups; g ++) {
+            candidate[g] = group_candidate<Int>(hulls, g, P, at[g]);
+            if (candidate[g] == NO_VERTEX) continue;
+            const point_coordinates &Q = hulls.vertices[hulls.first[g] + candidate[g]];
+            if (!found || wraps_before<Int>(P, next, Q)) next = Q;
+            found = true;
+        }
+        if (!found || same_point(next, hull[0])) return true; //every point equals hull[0], or the march is back at the start
+
+        hull.push_back(next);
+        for (std::size_t g = 0; g < groups; g ++) {
+            bool taken = candidate[g] != NO_VERTEX && same_point(hulls.vertices[hulls.first[g] + candidate[g]], next);
+            at[g] = taken ? candidate[g] : NO_VERTEX;
+        }
+    }
+    return false;
+}
+
+//chan's algorithm helper function
+//hull vertices counterclockwise from P_0, the lowest point
+template<typename Int, typename Points>
+std::vector<point_coordinates> chan_coordinates(const Points &points, const bounding_box &box) {
+    std::size_t n = points.size(), m = std::min<std::size_t>(256, n);
+    group_hulls hulls = point_group_hulls<Int>(points, m, box);
+
+    //the lowest point, the leftmost one on ties, is a vertex of the hull of its group
+    point_coordinates P_0 = hulls.vertices[0];
+    for (const auto &el:hulls.vertices) {
+        if (el.y < P_0.y || (el.y == P_0.y && el.x < P_0.x)) P_0 = el;
+    }
+
+    //a failed round leaves the hull vertices it found, the next one continues from the last of them
+    std::vector<point_coordinates> hull(1, P_0);
+    while (!jarvis_march<Int>(hulls, m, hull)) {
+        //a round with m >= n has room for every point and cannot fail unless a predicate is wrong:
+        //never round again with the same m, give the points to the monotone chain instead
+        if (m >= n) return monotone_chain_coordinates(points);
+
+        std::size_t next = m > n / m ? n : m * m;
+        hulls = merged_group_hulls<Int>(hulls, (next + m - 1) / m, box);
+        m = next;
+    }
+    return hull;
+}
+
+//convex hull by chan's algorithm in O(n log h) for h hull vertices, with the same output as graham_scan:
+//rounds with groups of m = 256, 65536, ... points (m squared every round) build the monotone chain hull of every
+//group and then jarvis march from the lowest point for at most m steps, wrapping to the best of the tangents of the
+//group hulls, each found by binary search; the first round with m >= h closes the hull. Only the first round sorts all
+//the points, the later ones merge the hull vertices of the previous groups, and it starts at 256 because the marches
+//of smaller rounds cost as much as their sorts and fail on most inputs. For millions of points with few hull vertices,
+//where sorting all of them is the bulk of the work; points is a vector of Point or point_arrays
+template<typename Points>
+std::vector<Point> chan_hull(const Points &points) {
+    std::size_t n = points.size();
+    if (n == 0) return std::vector<Point>();
+
+    bounding_box box = bounding_box_of(points, 0, n);
+    if (box.fits_long_products()) return hull_from_lowest(chan_coordinates<long int>(points, box));
+    return hull_from_lowest(chan_coordinates<wide_int>(points, box));
+}
+
+
+//online convex hull
+//online hull helper class
+//one monotone chain of the hull as an ordered map from x to y, left to right and turning counterclockwise:
+//the lower chain of the points (sign = 1), or the upper chain, stored as the lower chain of the mirrored points (x, -y) (sign = -1)
+//only strictly convex vertices are kept, points on an edge of the chain are dropped
+class hull_chain {
+public:
+    explicit hull_chain(long int chain_sign) : sign(chain_sign) {}
+
+    //add (x, y), return true if it became a vertex of the chain
+    //O(log n) plus O(log n) for every vertex it removes, so O(log n) amortized
+    bool insert(long int x, long int y) {
+        y *= sign;
+        Point P = make_point(x, y);
+
+        auto right = chain.lower_bound(x);
+        if (right != chain.end() && right->first == x) {
+            if (right->second <= y) return false; //a vertex at the same x is already lower
+            right = chain.erase(right); //the new point replaces it
+        }
+        else if (right != chain.end() && right != chain.begin()) {
+            //on or above the edge spanning x
+            if (ccw(vertex(std::prev(right)), vertex(right), P) >= 0) return false;
+        }
+
+        auto it = chain.emplace_hint(right, x, y);
+
+        //remove the vertices that no longer turn counterclockwise, on both sides of the new one
+        auto next = std::next(it);
+        while (next != chain.end() && std::next(next) != chain.end() && ccw(P, vertex(next), vertex(std::next(next))) <= 0) {
+            next = chain.erase(next);
+        }
+        while (it != chain.begin() && std::prev(it) != chain.begin()) {
+            auto prev = std::prev(it);
+            if (ccw(vertex(std::prev(prev)), vertex(prev), P) > 0) break;
+            chain.erase(prev);
+        }
+        return true;
+    }
+
+    //true if (x, y) is within the x range of the chain and on or above it (on or below for the upper chain), O(log n)
+    bool covers(long int x, long int y) const {
+        y *= sign;
+        if (chain.empty() || x < chain.begin()->first || x > std::prev(chain.end())->first) return false;
+
+        auto right = chain.lower_bound(x);
+        if (right->first == x) return right->second <= y;
+        return ccw(vertex(std::prev(right)), vertex(right), make_point(x, y)) >= 0;
+    }
+
+    //append the vertices from left to right to out, in the coordinates they were inserted with
+    void vertices(std::vector<Point> &out) const {
+        for (const auto &el:chain) out.push_back(make_point(el.first, el.second * sign));
+    }
+
+    bool empty() const { return chain.empty(); }
+
+    std::size_t size() const { return chain.size(); }
+
+private:
+    std::map<long int, long int> chain; //x -> y of every vertex, y multiplied by sign
+    long int sign; //1 for the lower chain, -1 for the upper chain
+
+    Point vertex(std::map<long int, long int>::const_iterator it) const { return make_point(it->first, it->second); }
+};
+
+//convex hull updated point by point, for points arriving as a stream:
+//insert and contains take O(log n) amortized, snapshot is linear in the number of hull vertices
+class online_hull {
+public:
+    online_hull() : lower(1), upper(-1) {}
+
+    //add a point, return true if it changed the hull
+    bool insert(long int x, long int y) {
+        bool lower_changed = lower.insert(x, y);
+        bool upper_changed = upper.insert(x, y);
+        return lower_changed || upper_changed;
+    }
+
+    bool insert(const Point &P) { return insert(P.x, P.y); }
+
+    //true if (x, y) is inside the hull or on its boundary
+    bool contains(long int x, long int y) const { return lower.covers(x, y) && upper.covers(x, y); }
+
+    bool contains(const Point &P) const { return contains(P.x, P.y); }
+
+    //the current hull vertices counterclockwise, starting from the lowest point (the leftmost one on ties)
+    //and without collinear points: the order of the graham scan in p1.cpp
+    std::vector<Point> snapshot() const {
+        std::vector<Point> hull, top;
+        lower.vertices(hull);
+        upper.vertices(top);
+        if (hull.empty()) return hull;
+
+        //the upper chain runs right to left, its ends are shared with the lower chain unless there is a vertical edge
+        for (auto it = top.rbegin(); it != top.rend(); it ++) {
+            bool right_end = it == top.rbegin() && it->y == hull.back().y;
+            bool left_end = std::next(it) == top.rend() && it->y == hull.front().y;
+            if (!right_end && !left_end) hull.push_back(*it);
+        }
+
+        auto lowest = std::min_element(hull.begin(), hull.end(), [](const Point &a, const Point &b) {
+            return a.y < b.y || (a.y == b.y && a.x < b.x);
+        });
+        std::rotate(hull.begin(), lowest, hull.end());
+        return hull;
+    }
+
+    bool empty() const { return lower.empty(); }
+
+private:
+    hull_chain lower;
+    hull_chain upper;
+};
+
+
+#endif //VE281P1_HULL_HPP
@@ -0,0 +1,234 @@
+// hull_bench.cpp
+//
+// Convex hull benchmark: runs every hull algorithm in hull.hpp over a grid of sizes
+// and point distributions, and prints one CSV row per combination with the time and the
+// peak heap memory of one run. Every hull is checked against the exact graham scan.
+// The _soa rows run on the points as coordinate arrays (point_arrays) instead of a vector<Point>.
+// The polygon_h distributions have exactly h hull vertices, to compare the output sensitive
+// chan_hull with the sorting hulls as h grows.
+//
+// usage: hull_bench [max_n] [algorithm]
+//   max_n      largest input size, sizes are the powers of ten from 10 up to max_n (default 1000000, at most 100000000)
+//   algorithm  only run algorithms whose name contains this string
+//
+// build: g++ -std=c++17 -O2 -pthread hull_bench.cpp -o hull_bench
+//        (add -mavx2 for the vectorized scans of the _soa rows)
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>   // For timing
+#include <cstdlib>  // For std::malloc / std::free
+#include <cstddef>
+#include <new>
+#include <cmath>
+#include <random>
+#include <algorithm>
+#include "hull.hpp"
+
+using namespace std;
+
+//bytes currently allocated on the heap, and their peak since the last reset
+static size_t heap_bytes = 0;
+static size_t peak_heap_bytes = 0;
+
+//every allocation starts with a header holding its size, so delete knows how many bytes it frees
+const size_t HEADER_BYTES = alignof(max_align_t);
+
+//keep the replaced delete out of line, otherwise gcc sees operator new paired with free and warns
+#if defined(__GNUC__)
+#define BENCH_NOINLINE __attribute__((noinline))
+#else
+#define BENCH_NOINLINE
+#endif
+
+void* operator new(size_t size) {
+    char *block = (char *)malloc(size + HEADER_BYTES);
+    if (!block) throw bad_alloc();
+    *(size_t *)block = size;
+    heap_bytes += size;
+    peak_heap_bytes = max(peak_heap_bytes, heap_bytes);
+    return block + HEADER_BYTES;
+}
+
+BENCH_NOINLINE void operator delete(void *ptr) noexcept {
+    if (!ptr) return;
+    char *block = (char *)ptr - HEADER_BYTES;
+    heap_bytes -= *(size_t *)block;
+    free(block);
+}
+
+BENCH_NOINLINE void operator delete(void *ptr, size_t) noexcept {
+    operator delete(ptr);
+}
+
+struct distribution_info {
+    string name;
+    bool duplicates; //many duplicate points or points sharing a ray from the lowest point
+};
+
+const vector<distribution_info> DISTRIBUTIONS = {
+    {"square", false},
+    {"disk", false},
+    {"circle", true},
+    {"duplicates", true},
+    {"collinear", true},
+    {"polygon_8", false},
+    {"polygon_64", false},
+    {"polygon_512", false},
+};
+
+//coordinates stay within +-2^20, so the floating point ccw of graham_scan is exact as well
+const double RADIUS = 1 << 20;
+
+//n points of the given distribution:
+//uniform in a square or a disk (few hull vertices), rounded onto a circle (most points on the hull),
+//drawn from 16 corners of a grid (almost all points duplicated), on a single line (all points on one ray from P_0),
+//or the h vertices of a regular polygon with the other points strictly inside it (polygon_h)
+vector<Point> make_points(const string &distribution, size_t n, mt19937_64 &rng) {
+    uniform_real_distribution<double> unit(-1.0, 1.0);
+    vector<Point> points(n);
+    size_t vertices = 0, first = 0;
+    if (distribution.compare(0, 8, "polygon_") == 0) {
+        vertices = min<size_t>(n, (size_t)stoul(distribution.substr(8)));
+        for (size_t i = 0; i < vertices; i ++) {
+            double angle = 2 * M_PI * (double)i / (double)vertices;
+            points[i] = make_point(lround(cos(angle) * RADIUS), lround(sin(angle) * RADIUS));
+        }
+        first = vertices;
+    }
+    //the disk inscribed in the polygon, shrunk by the rounding of its vertices
+    double inner = vertices ? cos(M_PI / (double)vertices) * RADIUS - 2 : 0;
+    for (auto el = points.begin() + (ptrdiff_t)first; el != points.end(); ++ el) {
+        double x, y;
+        if (distribution == "duplicates") {
+            x = (double)(rng() % 4) / 2 - 0.75;
+            y = (double)(rng() % 4) / 2 - 0.75;
+        }
+        else if (distribution == "collinear") {
+            x = unit(rng);
+            y = x / 2;
+        }
+        else if (distribution == "square") {
+            x = unit(rng);
+            y = unit(rng);
+        }
+        else if (distribution == "disk") {
+            do {
+                x = unit(rng);
+                y = unit(rng);
+            } while (x * x + y * y > 1);
+        }
+        else if (vertices) {
+            do {
+                x = unit(rng);
+                y = unit(rng);
+            } while (x * x + y * y > 1);
+            *el = make_point((long int)(x * inner), (long int)(y * inner));
+            continue;
+        }
+        else {
+            double angle = M_PI * unit(rng);
+            x = cos(angle);
+            y = sin(angle);
+        }
+        *el = make_point((long int)(x * RADIUS), (long int)(y * RADIUS));
+    }
+    if (vertices) shuffle(points.begin(), points.end(), rng); //the hull vertices anywhere in the input
+    return points;
+}
+
+struct algorithm_info {
+    string name;
+    bool quadratic; //O(n^2) on inputs with many duplicates: only run up to QUADRATIC_LIMIT points there
+};
+
+//duplicate heavy inputs above this size are skipped for quadratic algorithms
+const size_t QUADRATIC_LIMIT = 10000;
+
+const vector<algorithm_info> ALGORITHMS = {
+    {"graham_scan", true},
+    {"graham_scan_exact", false},
+    {"online_hull", false},
+    {"monotone_chain", false},
+    {"parallel_hull", false},
+    {"chan_hull", false},
+    {"graham_scan_exact_soa", false},
+    {"monotone_chain_soa", false},
+    {"parallel_hull_soa", false},
+    {"chan_hull_soa", false},
+};
+
+//run the named hull algorithm, the _soa ones on arrays, which hold the same points
+vector<Point> run_hull(const string &name, const vector<Point> &points, const point_arrays &arrays) {
+    if (name == "graham_scan_exact_soa") return graham_scan_exact(arrays);
+    if (name == "monotone_chain_soa") return monotone_chain(arrays);
+    if (name == "parallel_hull_soa") return parallel_hull(arrays);
+    if (name == "chan_hull_soa") return chan_hull(arrays);
+    if (name == "graham_scan") return graham_scan(points);
+    if (name == "graham_scan_exact") return graham_scan_exact(points);
+    if (name == "monotone_chain") return monotone_chain(points);
+    if (name == "parallel_hull") return parallel_hull(points);
+    if (name == "chan_hull") return chan_hull(points);
+
+    online_hull hull;
+    for (const Point &el:points) hull.insert(el);
+    return hull.snapshot();
+}
+
+//time one algorithm on one input and print its CSV row
+void bench(const string &algorithm, const string &distribution, const vector<Point> &points, const point_arrays &arrays,
+           const vector<Point> &expected) {
+    size_t n = points.size();
+
+    //repeat fast inputs until about 50 ms were measured, up to 10^6 points in total
+    size_t max_repeats = max<size_t>(1, 1000000 / max<size_t>(n, 1));
+    size_t repeats = 0;
+    double total_ns = 0;
+    size_t peak_bytes = 0; //peak heap memory of a run, including its result
+    vector<Point> hull;
+    while (repeats < max_repeats && total_ns < 5e7) {
+        repeats ++;
+        hull = vector<Point>();
+        size_t start_bytes = heap_bytes;
+        peak_heap_bytes = heap_bytes;
+        auto start = chrono::steady_clock::now();
+        hull = run_hull(algorithm, points, arrays);
+        auto end = chrono::steady_clock::now();
+        total_ns += chrono::duration<double, nano>(end - start).count();
+        peak_bytes = max(peak_bytes, peak_heap_bytes - start_bytes);
+    }
+
+    bool same = hull.size() == expected.size() && equal(hull.begin(), hull.end(), expected.begin(), [](const Point &a, const Point &b) {
+        return a.x == b.x && a.y == b.y;
+    });
+    if (!same) cerr << algorithm << " failed on " << distribution << " n=" << n << endl;
+
+    double ns = total_ns / (double)repeats;
+    cout << algorithm << ',' << distribution << ',' << n << ',' << ns / 1e6 << ','
+         << ns / (double)max<size_t>(n, 1) << ',' << peak_bytes << ',' << hull.size() << endl;
+}
+
+int main(int argc, char *argv[]) {
+    size_t max_n = argc > 1 ? (size_t)strtoull(argv[1], nullptr, 10) : 1000000;
+    max_n = min<size_t>(max_n, 100000000);
+    string filter = argc > 2 ? argv[2] : "";
+
+    mt19937_64 rng(281);
+    cout << "algorithm,distribution,n,ms,ns_per_point,peak_bytes,hull_vertices" << endl;
+
+    for (size_t n = 10; n <= max_n; n *= 10) {
+        for (const distribution_info &distribution:DISTRIBUTIONS) {
+            vector<Point> points = make_points(distribution.name, n, rng);
+            point_arrays arrays = make_point_arrays(points);
+            vector<Point> expected = graham_scan_exact(points);
+            for (const algorithm_info &algorithm:ALGORITHMS) {
+                if (algorithm.name.find(filter) == string::npos) continue;
+                if (algorithm.quadratic && distribution.duplicates && n > QUADRATIC_LIMIT) continue;
+                bench(algorithm.name, distribution.name, points, arrays, expected);
+            }
+        }
+    }
+
+    return 0;
+}
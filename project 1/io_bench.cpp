@@ -0,0 +1,162 @@
+// io_bench.cpp
+//
+// Point input / output benchmark: writes n random points in the text and the binary
+// format of p1, then times reading them back with the old getline + stringstream loop,
+// the text parser and the binary reader of point_io.hpp, and writing them with per line
+// endl and with write_points. Prints one CSV row per reader or writer with its MB/s.
+// The files are read from the page cache, so the numbers are parsing and copying speed;
+// the parse_ rows only visit the points, without building a vector<Point>.
+//
+// usage: io_bench [n] [directory]
+//   n          number of points (default 10000000)
+//   directory  where the input files are written (default /tmp)
+//
+// build: g++ -std=c++17 -O2 -pthread io_bench.cpp -o io_bench
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>   // For timing
+#include <random>
+#include <cstdio>
+#include "point_io.hpp"
+
+using namespace std;
+
+//seconds since start
+double seconds_since(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+//print the CSV row of one reader or writer
+void report(const string &operation, const string &format, size_t n, size_t bytes, double seconds) {
+    double mb = (double)bytes / 1e6;
+    cout << operation << ',' << format << ',' << n << ',' << mb << ',' << seconds * 1e3 << ',' << mb / seconds << endl;
+}
+
+bool same_points(const vector<Point> &a, const vector<Point> &b) {
+    return a.size() == b.size() && equal(a.begin(), a.end(), b.begin(), [](const Point &P, const Point &Q) {
+        return P.x == Q.x && P.y == Q.y;
+    });
+}
+
+//the reading loop p1 used before point_io.hpp
+vector<Point> read_getline(const string &path) {
+    ifstream in(path);
+    vector<Point> points;
+    stringstream ss;
+    string input_line;
+    getline(in, input_line); //the number of points
+    while (getline(in, input_line)) {
+        ss.str(input_line);
+        Point P = make_point(0, 0);
+        ss >> P.x >> P.y;
+        ss.clear();
+        points.push_back(P);
+    }
+    return points;
+}
+
+//time one reader of the file at path
+template<typename Read>
+void bench_read(const string &operation, const string &format, const string &path, size_t bytes,
+                const vector<Point> &expected, Read read_file) {
+    auto start = chrono::steady_clock::now();
+    vector<Point> points = read_file(path);
+    double seconds = seconds_since(start);
+    if (!same_points(points, expected)) cerr << operation << " read wrong points from " << path << endl;
+    report(operation, format, expected.size(), bytes, seconds);
+}
+
+//time one parser over the file at path, visiting the points without storing them
+template<typename Parse>
+void bench_parse(const string &operation, const string &format, const string &path, size_t bytes,
+                 const vector<Point> &expected, Parse parse) {
+    int fd = open(path.c_str(), O_RDONLY);
+    auto start = chrono::steady_clock::now();
+    input_buffer input(fd);
+    long int sum = 0;
+    size_t count = 0;
+    parse(input, [&sum, &count](long int x, long int y) {
+        sum += x ^ y;
+        count ++;
+    });
+    double seconds = seconds_since(start);
+    close(fd);
+
+    long int expected_sum = 0;
+    for (const auto &el:expected) expected_sum += el.x ^ el.y;
+    if (count != expected.size() || sum != expected_sum) cerr << operation << " parsed wrong points from " << path << endl;
+    report(operation, format, expected.size(), bytes, seconds);
+}
+
+int main(int argc, char *argv[]) {
+    size_t n = argc > 1 ? (size_t)strtoull(argv[1], nullptr, 10) : 10000000;
+    string directory = argc > 2 ? argv[2] : "/tmp";
+    string text_path = directory + "/io_bench_points.txt", binary_path = directory + "/io_bench_points.bin";
+
+    mt19937_64 rng(281);
+    uniform_int_distribution<long int> coordinate(-1000000000, 1000000000);
+    vector<Point> points(n);
+    for (auto &el:points) el = make_point(coordinate(rng), coordinate(rng));
+
+    //the input files, the text one in the format of p1
+    size_t text_bytes, binary_bytes = n * 2 * sizeof(int64_t);
+    {
+        ofstream text(text_path);
+        text << n << '\n';
+        write_points(text, points);
+        text_bytes = (size_t)text.tellp();
+
+        ofstream binary(binary_path, ios::binary);
+        for (const auto &el:points) {
+            int64_t xy[2] = {el.x, el.y};
+            binary.write((const char *)xy, sizeof(xy));
+        }
+    }
+
+    cout << "operation,format,n,mb,ms,mb_per_s" << endl;
+
+    bench_read("getline_stringstream", "text", text_path, text_bytes, points, read_getline);
+    bench_read("read_points_text", "text", text_path, text_bytes, points, [](const string &path) {
+        int fd = open(path.c_str(), O_RDONLY);
+        input_buffer input(fd);
+        close(fd);
+        long int num = 0;
+        return read_points_text(input.begin(), input.end(), num);
+    });
+    bench_read("read_points_binary", "binary", binary_path, binary_bytes, points, [](const string &path) {
+        int fd = open(path.c_str(), O_RDONLY);
+        input_buffer input(fd);
+        close(fd);
+        return read_points_binary(input.begin(), input.end());
+    });
+
+    bench_parse("parse_points_text", "text", text_path, text_bytes, points, [](const input_buffer &input, auto visit) {
+        long int num = 0;
+        parse_points_text(input.begin(), input.end(), num, visit);
+    });
+    bench_parse("parse_points_binary", "binary", binary_path, binary_bytes, points, [](const input_buffer &input, auto visit) {
+        parse_points_binary(input.begin(), input.end(), visit);
+    });
+
+    //writers, into /dev/null so only formatting and the write calls are measured
+    {
+        ofstream out("/dev/null");
+        auto start = chrono::steady_clock::now();
+        for (const auto &el:points) out << el.x << ' ' << el.y << endl;
+        report("endl", "text", n, text_bytes, seconds_since(start));
+    }
+    {
+        ofstream out("/dev/null");
+        auto start = chrono::steady_clock::now();
+        write_points(out, points);
+        report("write_points", "text", n, text_bytes, seconds_since(start));
+    }
+
+    remove(text_path.c_str());
+    remove(binary_path.c_str());
+    return 0;
+}
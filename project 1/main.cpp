@@ -1,6 +1,14 @@
 #include <iostream>
 #include <vector>
+#include <array>
+#include <deque>
 #include <algorithm>
+#include <iterator>
+#include <cstdio>
+#include <cstdlib>
+#include <cctype>
+#include <cmath>
+#include <string>
 #include "sort.hpp"
 
 using namespace std;
@@ -19,6 +27,308 @@ bool test_sort (const vector<T> sorted, void (*sort_func)(vector<T>&, Compare),
     return false; //array is not correctly sorted
 }
 
+//sort a file of random doubles 10 times bigger than memory_budget with external_sort
+//return true if the output file holds the same doubles in sorted order
+bool test_external_sort(size_t memory_budget) {
+    const string input_path = "external_sort_test.in";
+    const string output_path = "external_sort_test.out";
+
+    vector<double> records(10 * memory_budget / sizeof(double));
+    for (auto &el:records) el = rand() / (double)RAND_MAX;
+
+    FILE *input = fopen(input_path.c_str(), "wb");
+    if (!input) return false;
+    fwrite(records.data(), sizeof(double), records.size(), input);
+    fclose(input);
+
+    external_sort<double>(input_path, output_path, memory_budget, less<double>());
+
+    vector<double> sorted(records.size() + 1); //one extra slot to detect a too long output
+    FILE *output = fopen(output_path.c_str(), "rb");
+    if (!output) return false;
+    size_t count = fread(sorted.data(), sizeof(double), sorted.size(), output);
+    fclose(output);
+    remove(input_path.c_str());
+    remove(output_path.c_str());
+
+    sorted.resize(count);
+    sort(records.begin(), records.end());
+    return sorted == records;
+}
+
+//sort strings case insensitively and random ints by their last three digits with sort_by_key
+//return true if both orders match std::stable_sort with the equivalent comparator
+bool test_sort_by_key() {
+    auto lower = [](const string &s) {
+        string key = s;
+        for (auto &c:key) c = (char)tolower((unsigned char)c);
+        return key;
+    };
+    vector<string> words = {"banana", "Apple", "cherry", "apple", "Banana"};
+    sort_by_key(words, lower);
+    if (words != vector<string>({"Apple", "apple", "banana", "Banana", "cherry"})) return false;
+
+    vector<int> numbers(100000);
+    for (auto &el:numbers) el = rand();
+    vector<int> expected = numbers;
+    stable_sort(expected.begin(), expected.end(), [](int a, int b) { return a % 1000 > b % 1000; });
+    sort_by_key(numbers, [](int el) { return el % 1000; }, greater<int>());
+    return numbers == expected;
+}
+
+//check quick_select, partial_sort and top_k against a fully sorted copy of random ints
+//return true if every selected element is the one the full sort puts there
+bool test_selection(size_t n, size_t k) {
+    vector<int> unsorted(n);
+    for (auto &el:unsorted) el = rand() % 1000;
+    vector<int> sorted = unsorted;
+    sort(sorted.begin(), sorted.end());
+
+    vector<int> arr = unsorted;
+    quick_select(arr, k, less<int>());
+    if (arr[k] != sorted[k]) return false;
+
+    arr = unsorted;
+    partial_sort(arr, k, less<int>());
+    if (!equal(sorted.begin(), sorted.begin() + k, arr.begin())) return false;
+
+    return top_k(unsorted.begin(), unsorted.end(), k) == vector<int>(sorted.begin(), sorted.begin() + k);
+}
+
+//sort a std::array of ints with static_sort in a constant expression, and fixed size arrays
+//of strings and of random doubles through the std::array overload of sort
+//return true if all three are sorted
+bool test_static_sort() {
+    constexpr array<int, 6> folded = [] {
+        array<int, 6> arr = {6, 6, 5, 1, 0, 3};
+        static_sort(arr);
+        return arr;
+    }();
+    if (folded != array<int, 6>({0, 1, 3, 5, 6, 6})) return false;
+
+    array<string, 5> words = {"pear", "apple", "fig", "kiwi", "banana"};
+    sort(words, greater<string>());
+    if (words != array<string, 5>({"pear", "kiwi", "fig", "banana", "apple"})) return false;
+
+    array<double, 32> random;
+    for (auto &el:random) el = rand() / (double)RAND_MAX;
+    sort(random);
+    return is_sorted(random.begin(), random.end());
+}
+
+//sort URLs sharing a long prefix, with duplicates, by string_sort and check the lcp array
+//return true if the order matches std::sort and every lcp entry is the common prefix of its neighbours
+bool test_string_sort() {
+    vector<string> urls(20000);
+    for (auto &el:urls) el = "https://example.com/items/" + to_string(rand() % 5000) + (rand() % 2 ? "/" : "");
+    vector<string> expected = urls;
+    sort(expected.begin(), expected.end());
+
+    vector<size_t> lcp;
+    string_sort(urls, lcp);
+    if (urls != expected || lcp.size() != urls.size() || lcp[0] != 0) return false;
+    for (size_t i = 1; i < urls.size(); i ++) {
+        size_t common = mismatch(urls[i - 1].begin(), urls[i - 1].end(), urls[i].begin(), urls[i].end()).first - urls[i - 1].begin();
+        if (lcp[i] != common) return false;
+    }
+    return true;
+}
+
+//sort pairs by their first member with merge_sort_inplace and no scratch memory at all
+//return true if the order matches std::stable_sort, so equal keys kept their input order
+bool test_merge_sort_inplace() {
+    vector<pair<int, int>> pairs(10000);
+    for (size_t i = 0; i < pairs.size(); i ++) pairs[i] = make_pair(rand() % 100, (int)i);
+    auto by_first = [](const pair<int, int> &a, const pair<int, int> &b) { return a.first < b.first; };
+    vector<pair<int, int>> expected = pairs;
+    stable_sort(expected.begin(), expected.end(), by_first);
+    merge_sort_inplace(pairs, by_first, 0);
+    return pairs == expected;
+}
+
+//quick_sort_intro and heap_sort random ints with many duplicates, large enough for ninther pivots and hoare partitions,
+//then run the introsort loop with depth limits 0 and 3, so heap sort finishes the whole range and then subranges
+//return true if every result matches std::sort
+bool test_quick_sort_intro() {
+    vector<int> unsorted(100000);
+    for (auto &el:unsorted) el = rand() % 1000;
+    vector<int> expected = unsorted;
+    sort(expected.begin(), expected.end());
+
+    vector<int> arr = unsorted;
+    quick_sort_intro(arr, less<int>());
+    if (arr != expected) return false;
+    arr = unsorted;
+    heap_sort(arr, less<int>());
+    if (arr != expected) return false;
+
+    for (size_t depth_limit:{0, 3}) {
+        arr = unsorted;
+        introsort_loop(arr, 0, arr.size(), depth_limit, less<int>());
+        if (arr != expected) return false;
+    }
+    return true;
+}
+
+//sort 10^5 pairs with few distinct keys by their key on 4 threads with a grain of 64, so both parallel sorts
+//really fork and merge_sort_parallel merges through the shared buffer
+//return true if merge_sort_parallel matches std::stable_sort, so equal keys kept their input order,
+//and quick_sort_parallel puts the keys in the same order
+bool test_parallel_sort() {
+    vector<pair<int, int>> unsorted(100000);
+    for (size_t i = 0; i < unsorted.size(); i ++) unsorted[i] = make_pair(rand() % 100, (int)i);
+    auto by_first = [](const pair<int, int> &a, const pair<int, int> &b) { return a.first < b.first; };
+    vector<pair<int, int>> expected = unsorted;
+    stable_sort(expected.begin(), expected.end(), by_first);
+
+    vector<pair<int, int>> pairs = unsorted;
+    merge_sort_parallel(pairs, by_first, 64, 4);
+    if (pairs != expected) return false;
+
+    pairs = unsorted;
+    quick_sort_parallel(pairs, by_first, 64, 4);
+    return equal(pairs.begin(), pairs.end(), expected.begin(), [](const pair<int, int> &a, const pair<int, int> &b) { return a.first == b.first; });
+}
+
+//sample sort random ints with few distinct values and random doubles on 4 threads with a small grain,
+//so that both go through the bucket classification even on a single core machine
+//return true if both match std::sort
+bool test_sample_sort() {
+    vector<int> few(100000);
+    for (auto &el:few) el = rand() % 10;
+    vector<int> expected = few;
+    sort(expected.begin(), expected.end(), greater<int>());
+    sample_sort(few, greater<int>(), 1000, 4);
+    if (few != expected) return false;
+
+    vector<double> random(100003);
+    for (auto &el:random) el = rand() / (double)RAND_MAX;
+    vector<double> sorted = random;
+    sort(sorted.begin(), sorted.end());
+    sample_sort(random, less<double>(), 1000, 4);
+    return random == sorted;
+}
+
+//sort pairs by their first member with merge_sort_adaptive, the input being sorted runs of 1000 to 5000 pairs
+//over 50 keys: runs of equal keys make both merge directions gallop, in the shorter left and the shorter right run
+//return true if the order matches std::stable_sort, so equal keys kept their input order
+bool test_merge_sort_adaptive() {
+    vector<pair<int, int>> pairs;
+    while (pairs.size() < 100000) {
+        size_t first = pairs.size(), len = 1000 + (size_t)(rand() % 4001);
+        for (size_t i = 0; i < len; i ++) pairs.push_back(make_pair(rand() % 50, (int)(first + i)));
+        sort(pairs.begin() + (ptrdiff_t)first, pairs.end());
+    }
+    auto by_first = [](const pair<int, int> &a, const pair<int, int> &b) { return a.first < b.first; };
+    vector<pair<int, int>> expected = pairs;
+    stable_sort(expected.begin(), expected.end(), by_first);
+    merge_sort_adaptive(pairs, by_first);
+    return pairs == expected;
+}
+
+//sort a std::deque and the middle of a raw buffer in place through the iterator overloads
+//return true if both are sorted and the untouched ends of the buffer kept their values
+bool test_iterator_sort() {
+    deque<double> d = {6, 6, 5.7, 1.9, 0.5};
+    quick_sort_intro(d.begin(), d.end());
+    merge_sort_adaptive(d.begin(), d.end(), greater<double>());
+    if (d != deque<double>({6, 6, 5.7, 1.9, 0.5})) return false;
+
+    int buffer[] = {9, 4, 7, 1, 8, 2, 0};
+    radix_sort(buffer + 1, buffer + 6);
+    int expected[] = {9, 1, 2, 4, 7, 8, 0};
+    return equal(begin(buffer), end(buffer), begin(expected));
+}
+
+//sort doubles and floats mixing 0.0 and -0.0, which compare equal, with every sort that reaches the sorting networks,
+//at sizes filling the 8, 16 and 32 element networks
+//return true if every output is sorted and keeps as many -0.0 as its input
+template<typename T>
+bool test_signed_zero() {
+    void (*sorts[])(vector<T>&, less<T>) = {merge_sort, quick_sort_inplace, quick_sort_intro, quick_sort_3way,
+                                            merge_sort_buffered, merge_sort_inplace, merge_sort_parallel, quick_sort_parallel,
+                                            sample_sort, radix_sort, sort, quick_sort_block, merge_sort_adaptive};
+    for (size_t n:{3, 8, 13, 16, 27, 32, 1000}) {
+        vector<T> unsorted(n);
+        for (auto &el:unsorted) el = rand() % 3 == 0 ? (T)(rand() % 3) : (rand() % 2 ? (T)0.0 : (T)-0.0);
+        size_t negative_zeros = (size_t)count_if(unsorted.begin(), unsorted.end(), [](T el) { return el == 0 && signbit(el); });
+        for (auto sort_func:sorts) {
+            vector<T> arr = unsorted;
+            sort_func(arr, less<T>());
+            size_t kept = (size_t)count_if(arr.begin(), arr.end(), [](T el) { return el == 0 && signbit(el); });
+            if (!is_sorted(arr.begin(), arr.end()) || kept != negative_zeros) return false;
+        }
+    }
+
+    //merge sort is stable, so the zeros keep their input order
+    vector<T> zeros = {(T)0.0, (T)-0.0, (T)1.0};
+    merge_sort(zeros, less<T>());
+    return !signbit(zeros[0]) && signbit(zeros[1]) && zeros[2] == 1;
+}
+
+#if defined(__cpp_lib_span)
+//the std::span overloads only exist from C++20 on: build main.cpp with -std=c++20 to run this test
+//sort the middle of a buffer through the span overload of every sort, a fixed size span through the static network,
+//and strings, keys and selections through their span overloads
+//return true if every result matches std::sort and the ends of the buffer kept their values
+bool test_span_sort() {
+    void (*sorts[])(span<int>, less<int>) = {bubble_sort, insertion_sort, selection_sort, merge_sort, quick_sort_inplace,
+                                             quick_sort_extra, heap_sort, quick_sort_intro, quick_sort_block, quick_sort_3way,
+                                             quick_sort_extra_3way, merge_sort_buffered, merge_sort_parallel, quick_sort_parallel,
+                                             merge_sort_inplace, sample_sort, radix_sort, merge_sort_adaptive, sort};
+    vector<int> unsorted(1002);
+    for (auto &el:unsorted) el = rand() % 500;
+    vector<int> expected = unsorted;
+    sort(expected.begin() + 1, expected.end() - 1);
+    for (auto sort_func:sorts) {
+        vector<int> arr = unsorted;
+        sort_func(span<int>(arr.data() + 1, arr.size() - 2), less<int>());
+        if (arr != expected) return false;
+    }
+
+    array<double, 12> fixed = {6, 6, 5.7, 1.9, 0.5, -1, 3, 2, 8, 7, 0, 4};
+    sort(span<double, 12>(fixed), greater<double>());
+    if (!is_sorted(fixed.begin(), fixed.end(), greater<double>())) return false;
+
+    vector<string> words = {"pear", "apple", "fig", "apricot"};
+    vector<size_t> lcp(words.size());
+    string_sort(span<string>(words), lcp.data());
+    if (words != vector<string>({"apple", "apricot", "fig", "pear"}) || lcp != vector<size_t>({0, 2, 0, 0})) return false;
+
+    sort_by_key(span<string>(words), [](const string &el) { return el.size(); });
+    if (words != vector<string>({"fig", "pear", "apple", "apricot"})) return false;
+
+    vector<int> arr = unsorted;
+    quick_select(span<int>(arr), 500, less<int>());
+    vector<int> sorted = unsorted;
+    sort(sorted.begin(), sorted.end());
+    if (arr[500] != sorted[500]) return false;
+
+    arr = unsorted;
+    partial_sort(span<int>(arr), 10, less<int>());
+    return equal(sorted.begin(), sorted.begin() + 10, arr.begin());
+}
+#endif
+
+//count the work of insertion sort on a reversed vector of 100 elements, which needs
+//exactly 100 * 99 / 2 comparisons and swaps, and the recursion of merge sort on 1024 elements
+//return true if the counted numbers are the expected ones
+bool test_instrumentation() {
+    vector<int> reversed(100);
+    for (size_t i = 0; i < reversed.size(); i ++) reversed[i] = (int)(reversed.size() - i);
+    sort_stats stats = sort_instrumented(reversed, less<int>(), [](auto first, auto last, auto comp) {
+        insertion_sort(first, last, comp);
+    });
+    if (stats.comparisons != 4950 || stats.swaps != 4950 || stats.allocations != 0) return false;
+
+    vector<double> random(1024);
+    for (auto &el:random) el = rand();
+    stats = sort_instrumented(random, less<double>(), [](auto first, auto last, auto comp) {
+        merge_sort(first, last, comp);
+    });
+    return stats.max_depth > 0 && stats.max_depth <= 11 && stats.allocations > 0 && is_sorted(random.begin(), random.end());
+}
+
 int main () {
 
     vector<double> unsorted_arr = {6, 6, 5.7, 1.9, 0.5};
@@ -63,6 +373,140 @@ int main () {
         cout << "correct" << endl;
     }
     else cout << "incorrect" << endl;
+
+    cout << "quick sort intro : ";
+    if (test_sort (sorted_arr, quick_sort_intro, unsorted_arr, less<double>()) && test_quick_sort_intro()) {
+        cout << "correct" << endl;
+    }
+    else cout << "incorrect" << endl;
+
+    cout << "heap sort : ";
+    if (test_sort (sorted_arr, heap_sort, unsorted_arr, less<double>())) {
+        cout << "correct" << endl;
+    }
+    else cout << "incorrect" << endl;
+
+    cout << "quick sort 3way : ";
+    if (test_sort (sorted_arr, quick_sort_3way, unsorted_arr, less<double>())) {
+        cout << "correct" << endl;
+    }
+    else cout << "incorrect" << endl;
+
+    cout << "quick sort extra 3way : ";
+    if (test_sort (sorted_arr, quick_sort_extra_3way, unsorted_arr, less<double>())) {
+        cout << "correct" << endl;
+    }
+    else cout << "incorrect" << endl;
+
+    cout << "merge sort buffered : ";
+    if (test_sort (sorted_arr, merge_sort_buffered, unsorted_arr, less<double>())) {
+        cout << "correct" << endl;
+    }
+    else cout << "incorrect" << endl;
+
+    cout << "merge sort inplace : ";
+    if (test_sort (sorted_arr, merge_sort_inplace, unsorted_arr, less<double>()) && test_merge_sort_inplace()) {
+        cout << "correct" << endl;
+    }
+    else cout << "incorrect" << endl;
+
+    cout << "merge sort parallel : ";
+    if (test_sort (sorted_arr, merge_sort_parallel, unsorted_arr, less<double>()) && test_parallel_sort()) {
+        cout << "correct" << endl;
+    }
+    else cout << "incorrect" << endl;
+
+    cout << "quick sort parallel : ";
+    if (test_sort (sorted_arr, quick_sort_parallel, unsorted_arr, less<double>()) && test_parallel_sort()) {
+        cout << "correct" << endl;
+    }
+    else cout << "incorrect" << endl;
+
+    cout << "sample sort : ";
+    if (test_sort (sorted_arr, sample_sort, unsorted_arr, less<double>()) && test_sample_sort()) {
+        cout << "correct" << endl;
+    }
+    else cout << "incorrect" << endl;
+
+    cout << "radix sort : ";
+    if (test_sort (sorted_arr, radix_sort, unsorted_arr, less<double>())) {
+        cout << "correct" << endl;
+    }
+    else cout << "incorrect" << endl;
+
+    cout << "sort : ";
+    if (test_sort (sorted_arr, sort, unsorted_arr, less<double>())) {
+        cout << "correct" << endl;
+    }
+    else cout << "incorrect" << endl;
+
+    cout << "merge sort adaptive : ";
+    if (test_sort (sorted_arr, merge_sort_adaptive, unsorted_arr, less<double>()) && test_merge_sort_adaptive()) {
+        cout << "correct" << endl;
+    }
+    else cout << "incorrect" << endl;
+
+    cout << "quick sort block : ";
+    if (test_sort (sorted_arr, quick_sort_block, unsorted_arr, less<double>())) {
+        cout << "correct" << endl;
+    }
+    else cout << "incorrect" << endl;
+
+    cout << "static sort : ";
+    if (test_static_sort()) {
+        cout << "correct" << endl;
+    }
+    else cout << "incorrect" << endl;
+
+    cout << "string sort : ";
+    if (test_string_sort()) {
+        cout << "correct" << endl;
+    }
+    else cout << "incorrect" << endl;
+
+    cout << "sort by key : ";
+    if (test_sort_by_key()) {
+        cout << "correct" << endl;
+    }
+    else cout << "incorrect" << endl;
+
+    cout << "selection : ";
+    if (test_selection(100000, 10) && test_selection(100000, 50000)) {
+        cout << "correct" << endl;
+    }
+    else cout << "incorrect" << endl;
+
+    cout << "signed zero : ";
+    if (test_signed_zero<double>() && test_signed_zero<float>()) {
+        cout << "correct" << endl;
+    }
+    else cout << "incorrect" << endl;
+
+    cout << "iterator interface : ";
+    if (test_iterator_sort()) {
+        cout << "correct" << endl;
+    }
+    else cout << "incorrect" << endl;
+
+#if defined(__cpp_lib_span)
+    cout << "span interface : ";
+    if (test_span_sort()) {
+        cout << "correct" << endl;
+    }
+    else cout << "incorrect" << endl;
+#endif
+
+    cout << "instrumentation : ";
+    if (test_instrumentation()) {
+        cout << "correct" << endl;
+    }
+    else cout << "incorrect" << endl;
+
+    cout << "external sort : ";
+    if (test_external_sort(1 << 20)) {
+        cout << "correct" << endl;
+    }
+    else cout << "incorrect" << endl;
     // copy(arr.begin(), arr.end(), ostream_iterator<int>(cout, " "));
     // cout << endl;
 
@@ -5,142 +5,106 @@
 #include <iostream>
 #include <sstream>
 #include <cmath>
+#include "hull.hpp"
+#include "point_io.hpp"
 
 using namespace std;
 
-struct Point {
-    long int x; //x-coordinate of the point
-    long int y; //y-coordinate of the point
-    double polar_angle; //the polar angle with lowest point
-    long double distance; //the distance from between the point to lowest point
-    bool lowest_point; //return true if it is the lowest point
-};
+//streaming mode: insert every point into an online hull as it is parsed
+//and print the hull once the input ends, in the same order as the graham scan
+int stream_hull(const input_buffer &input, bool binary) {
+    online_hull hull;
+    auto insert = [&hull](long int x, long int y) { hull.insert(x, y); };
 
-double polar_angle(Point P_0, Point point) {
-    long int y = point.y - P_0.y;
-    long int x = point.x - P_0.x;
+    long int num = 0; //the number of points is not needed
+    if (binary) parse_points_binary(input.begin(), input.end(), insert);
+    else parse_points_text(input.begin(), input.end(), num, insert);
 
-    double rad = atan2(y, x); //calculated polar angle in radius
-
-    return rad * (180 / M_PI);
+    write_points(cout, hull.snapshot());
+    return 0;
 }
 
+//hull of the points stored as coordinate arrays, by the exact graham scan, the monotone chain, the parallel hull or chan's algorithm
+int array_hull(const input_buffer &input, bool binary, const string &mode) {
+    long int num = 0; //total number of points
+    point_arrays points;
+    if (binary) {
+        points = read_point_arrays_binary(input.begin(), input.end());
+        num = (long int)points.size();
+    }
+    else {
+        points = read_point_arrays_text(input.begin(), input.end(), num);
+    }
 
-bool compare_polar_angle(const Point &P_0,const Point &P_1) {
-    return P_0.polar_angle < P_1.polar_angle;
+    vector<Point> stack;
+    if (num != 0) {
+        if (mode == "--exact") stack = graham_scan_exact(points);
+        else if (mode == "--monotone") stack = monotone_chain(points);
+        else if (mode == "--chan") stack = chan_hull(points);
+        else stack = parallel_hull(points);
+    }
+    write_points(cout, stack);
+    return 0;
 }
 
-double ccw(const Point &P_1, const Point &P_2, const Point &P_3){
-    return ((double)P_2.x - (double)P_1.x)*((double)P_3.y - (double)P_1.y) - ((double)P_2.y - (double)P_1.y)*((double)P_3.x - (double)P_1.x);
-}
+//usage, printed for --help and to standard error for an unknown argument
+const char USAGE[] =
+    "usage: p1 [--binary] [--stream | --exact | --monotone | --parallel | --chan] < points\n"
+    "  --binary    the input is packed int64 x, y pairs instead of text\n"
+    "  the --exact, --monotone, --parallel and --chan hulls keep the points as coordinate arrays, 16 bytes per point\n"
+    "  --stream    build the hull incrementally while reading instead of with a graham scan over all points\n"
+    "  --exact     graham scan sorting by exact integer cross products instead of atan2 angles\n"
+    "  --monotone  andrew's monotone chain over the radix sorted points, linear after the sort even with many duplicates\n"
+    "  --parallel  filter the interior points and build local hulls on all hardware threads, then merge them\n"
+    "  --chan      chan's algorithm, O(n log h) for h hull vertices, for large inputs with few of them\n";
+
+//a failed read of the input is reported by the catch at the end
+int main(int argc, char *argv[]) try {
+    string mode = "";
+    bool binary = false;
+    for (int i = 1; i < argc; i ++) {
+        string arg = argv[i];
+        if (arg == "--binary") binary = true;
+        else if (arg == "--help") {
+            cout << USAGE;
+            return 0;
+        }
+        else if (arg == "--stream" || arg == "--exact" || arg == "--monotone" || arg == "--parallel" || arg == "--chan") mode = arg;
+        else {
+            cerr << "p1: unknown argument " << arg << "\n" << USAGE;
+            return 1;
+        }
+    }
+
+    input_buffer input(0); //standard input, mapped when it is redirected from a file
+    if (mode == "--stream") return stream_hull(input, binary);
+    if (mode == "--exact" || mode == "--monotone" || mode == "--parallel" || mode == "--chan") return array_hull(input, binary, mode);
 
-int main() {
     long int num = 0; //total number of points
-    unsigned long int index = 0; //index in the array of the lowest coordinate point
-    Point P_0; //lowest coordinate point
     vector<Point> stack; //stack to store the convex hull
     vector<Point> points; //array to store all the points
 
-    stringstream ss; //use to stream input and output 
-    string input_line; //string to store input line 
-
-    getline(cin, input_line);
-    ss.str(input_line);
-    ss >> num; // store the total number of point from the first input line
-    ss.clear();
-
     //read and store all the points in points array
-    while (getline(cin, input_line)) {
-        ss.str(input_line);
-        Point P;
-        ss >> P.x >> P.y;
-        ss.clear();
-        points.push_back(P);
-
-        //find the lowest y - coordinate points
-        if (points.size() == 1) {
-            points[0].lowest_point = true;
-            P_0 = points[0];
-        }
-        else if (points.back().y < points[index].y) {
-            points[index].lowest_point = false;
-            points.back().lowest_point = true; //indicate the points is lowest points
-            index = points.size() - 1; //set the index of the lowest point in points array
-            P_0 = points[index];
-
-        }
-        else if (points.back().y == points[index].y) {
-            if (points.back().x < points[index].x) {
-                //set the points that has the lowest x coordinate as the lowest points, if both y - coordinate is the same
-                points[index].lowest_point = false;
-                points.back().lowest_point = true; 
-                index = points.size() - 1; 
-                P_0 = points[index];
-            }
-        }
+    if (binary) {
+        points = read_points_binary(input.begin(), input.end());
+        num = (long int)points.size();
     }
-
-    //calculate the polar angle of the all the points 
-    //calculate the distance from the point to the lowest point
-    for (auto &el:points) {
-        el.polar_angle = polar_angle(P_0, el);
-        el.distance = sqrt(pow(el.x - P_0.x, 2) + pow(el.y - P_0.y, 2));
+    else {
+        points = read_points_text(input.begin(), input.end(), num);
     }
 
-    //if P_0 is not at first index, swap the P_0 with the element at the first index
-    if (index != 0 && num != 0) {
-        swap(points[index], points[0]);
-    } 
-
     if (num != 0) {
-        //sort the array base on polar angle compared to the lowest point coordinate
-        //sort from smallest to largest angle
-        sort(points.begin() + 1, points.end(), compare_polar_angle);
-
-        //remove element that has same coordinate as P_0
-        for (unsigned long int i = 1; i < points.size(); ) {
-            if (points[i].x == P_0.x && points[i].y == P_0.y) {
-                //remove the points with the same coordinate as P_0
-                points.erase(points.begin() + (long int)i);
-            }
-            else {
-                i ++;
-            }
-        }
-
-        //remove points that are have the same polar angle and only keep the point that has furthest distance from lowest point 
-        for (int i = 1; i < (int)points.size() - 1; ) {
-            //start from index 1 to skip out the first element (P_0)
-            if (points[(unsigned long int)i].polar_angle == points[(unsigned long int)i + 1].polar_angle) {
-                //remove the points that have same polar angle that are not the furthest 
-                if (points[(unsigned long int)i].distance < points[(unsigned long int)i + 1].distance) {
-                    points.erase(points.begin() + (long int)i);
-                }
-                else {
-                    points.erase(points.begin() + (long int)i + 1);
-                }
-            }
-            else {
-                i ++;
-            }
-        }
-
-        //graham scan 
-        for (auto &el:points) {
-            while (stack.size() > 1 && (ccw(stack[stack.size() - 2], stack.back(), el) <= 0)) {
-                stack.pop_back(); //pop the last element from the stack
-            }
-            stack.push_back(el);
-        }
-
+        stack = graham_scan(points);
     }
 
     // print out the convex hull to terminal
-    for (auto el:stack) {
-        cout << el.x << ' ' << el.y << endl;
-    }
+    write_points(cout, stack);
 
 
 
     return 0;
-}
\ No newline at end of file
+}
+catch (const exception &error) {
+    cerr << "p1: " << error.what() << "\n";
+    return 1;
+}
@@ -0,0 +1,168 @@
+#ifndef VE281P1_POINT_IO_HPP
+#define VE281P1_POINT_IO_HPP
+
+
+#include <vector>
+#include <string>
+#include <ostream>
+#include <cstdint>
+#include <cstring>
+#include <charconv>
+#include <algorithm>
+#include <stdexcept>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "hull.hpp"
+
+//point input and output of the hull tool, in two formats:
+//text, the number of points on the first line and then one "x y" pair per line,
+//and binary, packed native endian int64 x, y pairs without a header
+
+//the whole content of a file descriptor in memory:
+//mapped when it is a regular file, so a redirected input is never copied, and read into a buffer otherwise (pipes, terminals)
+//throw std::runtime_error if reading fails, a read interrupted by a signal is retried
+class input_buffer {
+public:
+    explicit input_buffer(int fd) {
+        struct stat info;
+        if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+            void *map = mmap(nullptr, (std::size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (map != MAP_FAILED) {
+                mapped = (char *)map;
+                length = (std::size_t)info.st_size;
+                madvise(map, length, MADV_SEQUENTIAL);
+                return;
+            }
+        }
+
+        copy.resize(1 << 16);
+        for (;;) {
+            if (length == copy.size()) copy.resize(copy.size() * 2);
+            ssize_t got = read(fd, copy.data() + length, copy.size() - length);
+            if (got < 0 && errno == EINTR) continue;
+            if (got < 0) throw std::runtime_error(std::string("input_buffer: read failed: ") + std::strerror(errno));
+            if (got == 0) break;
+            length += (std::size_t)got;
+        }
+    }
+
+    input_buffer(const input_buffer &) = delete;
+    input_buffer &operator=(const input_buffer &) = delete;
+
+    ~input_buffer() {
+        if (mapped) munmap(mapped, length);
+    }
+
+    const char *begin() const { return mapped ? mapped : copy.data(); }
+
+    const char *end() const { return begin() + length; }
+
+    std::size_t size() const { return length; }
+
+private:
+    char *mapped = nullptr; //the mapping, or nullptr when the input was read into copy
+    std::size_t length = 0;
+    std::vector<char> copy;
+};
+
+//point input helper function
+//parse the decimal integer at p after skipping whitespace, and advance p past it
+//return false at the end of the input or at anything that is not a number
+inline bool parse_long(const char *&p, const char *end, long int &value) {
+    while (p != end && (unsigned char)*p <= ' ') p ++;
+    if (p == end) return false;
+
+    bool negative = *p == '-';
+    if (*p == '-' || *p == '+') p ++;
+    if (p == end || *p < '0' || *p > '9') return false;
+
+    std::uint64_t magnitude = 0;
+    while (p != end && *p >= '0' && *p <= '9') magnitude = magnitude * 10 + (std::uint64_t)(*p ++ - '0');
+    value = (long int)(negative ? 0 - magnitude : magnitude);
+    return true;
+}
+
+//parse the text format in [first, last): the count on the first line goes to num, and visit(x, y) is called
+//for every following pair of integers; nothing is allocated, the caller decides where the points go
+template<typename Visit>
+void parse_points_text(const char *first, const char *last, long int &num, Visit visit) {
+    num = 0;
+    if (!parse_long(first, last, num)) return;
+
+    long int x, y;
+    while (parse_long(first, last, x) && parse_long(first, last, y)) visit(x, y);
+}
+
+//parse the binary format in [first, last), calling visit(x, y) for every complete pair
+template<typename Visit>
+void parse_points_binary(const char *first, const char *last, Visit visit) {
+    std::size_t n = (std::size_t)(last - first) / (2 * sizeof(std::int64_t));
+    for (std::size_t i = 0; i < n; i ++) {
+        std::int64_t xy[2];
+        std::memcpy(xy, first + i * sizeof(xy), sizeof(xy)); //the input need not be aligned
+        visit((long int)xy[0], (long int)xy[1]);
+    }
+}
+
+//points of the text format, num is the count on the first line
+inline std::vector<Point> read_points_text(const char *first, const char *last, long int &num) {
+    std::vector<Point> points;
+    bool counted = false;
+    parse_points_text(first, last, num, [&](long int x, long int y) {
+        //every point takes at least 4 characters, so a wrong count cannot reserve too much
+        if (!counted && num > 0) points.reserve(std::min((std::size_t)num, (std::size_t)(last - first) / 4));
+        counted = true;
+        points.push_back(make_point(x, y));
+    });
+    return points;
+}
+
+//points of the binary format
+inline std::vector<Point> read_points_binary(const char *first, const char *last) {
+    std::vector<Point> points;
+    points.reserve((std::size_t)(last - first) / (2 * sizeof(std::int64_t)));
+    parse_points_binary(first, last, [&](long int x, long int y) { points.push_back(make_point(x, y)); });
+    return points;
+}
+
+//points of the text format as coordinate arrays, 16 bytes per point, num is the count on the first line
+inline point_arrays read_point_arrays_text(const char *first, const char *last, long int &num) {
+    point_arrays points;
+    bool counted = false;
+    parse_points_text(first, last, num, [&](long int x, long int y) {
+        if (!counted && num > 0) points.reserve(std::min((std::size_t)num, (std::size_t)(last - first) / 4));
+        counted = true;
+        points.push_back(x, y);
+    });
+    return points;
+}
+
+//points of the binary format as coordinate arrays
+inline point_arrays read_point_arrays_binary(const char *first, const char *last) {
+    point_arrays points;
+    points.reserve((std::size_t)(last - first) / (2 * sizeof(std::int64_t)));
+    parse_points_binary(first, last, [&](long int x, long int y) { points.push_back(x, y); });
+    return points;
+}
+
+//write the points as "x y" lines, formatted into one buffer and written at once instead of flushed line by line
+inline void write_points(std::ostream &out, const std::vector<Point> &points) {
+    std::string buffer;
+    buffer.reserve(points.size() * 24);
+    char line[48];
+    for (const auto &el:points) {
+        char *p = std::to_chars(line, line + 20, el.x).ptr;
+        *p ++ = ' ';
+        p = std::to_chars(p, p + 20, el.y).ptr;
+        *p ++ = '\n';
+        buffer.append(line, p);
+    }
+    out.write(buffer.data(), (std::streamsize)buffer.size());
+    out.flush();
+}
+
+
+#endif //VE281P1_POINT_IO_HPP
@@ -5,18 +5,179 @@
 #include <vector>
 #include <stdlib.h>
 #include <functional>
+#include <algorithm>
+#include <utility>
+#include <thread>
+#include <type_traits>
+#include <limits>
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <memory>
+#include <future>
+#include <stdexcept>
+#include <iterator>
+#include <atomic>
+#include <array>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(__has_include)
+#if __has_include(<span>) && __cplusplus >= 202002L
+#include <span>
+#endif
+#endif
+
+//random access view of [first, last), the storage every algorithm below sorts through:
+//the vector, span and iterator overloads of the sorts all end up on a sort_range, which is
+//indexed like a vector but only refers to the elements, so nothing is copied
+template<typename RandomIt>
+class sort_range {
+public:
+    using iterator = RandomIt;
+    using value_type = typename std::iterator_traits<RandomIt>::value_type;
+    using reference = typename std::iterator_traits<RandomIt>::reference;
+
+    sort_range(RandomIt range_first, RandomIt range_last) : first(range_first), last(range_last) {}
+
+    RandomIt begin() const { return first; }
+    RandomIt end() const { return last; }
+    std::size_t size() const { return (std::size_t)(last - first); }
+    reference operator[](std::size_t i) const { return first[(std::ptrdiff_t)i]; }
+
+private:
+    RandomIt first;
+    RandomIt last;
+};
+
+//element type of a range: a std::vector or a sort_range
+template<typename Range>
+using range_value_t = typename Range::value_type;
+
+//true for ranges whose elements are contiguous in memory, the SIMD kernels need a plain pointer
+template<typename Range>
+struct is_contiguous_range : std::false_type {};
+
+template<typename T, typename Alloc>
+struct is_contiguous_range<std::vector<T, Alloc>> : std::integral_constant<bool, !std::is_same<T, bool>::value> {};
 
-//swap helper function
 template<typename T>
-void swap(std::vector<T> &vector, std::size_t i, std::size_t j) {
+struct is_contiguous_range<sort_range<T *>> : std::true_type {};
+
+//true for iterators into contiguous storage that are known without C++20 concepts:
+//pointers and std::vector iterators
+template<typename RandomIt>
+struct is_contiguous_iterator : std::integral_constant<bool, std::is_pointer<RandomIt>::value ||
+    (!std::is_same<typename std::iterator_traits<RandomIt>::value_type, bool>::value &&
+     std::is_same<RandomIt, typename std::vector<typename std::iterator_traits<RandomIt>::value_type>::iterator>::value)> {};
+
+//the sort_range of [first, last): contiguous storage is viewed through plain pointers,
+//so vectors, arrays and raw buffers share one instantiation and keep the SIMD paths
+template<typename RandomIt>
+auto make_sort_range(RandomIt first, RandomIt last) {
+    if constexpr (is_contiguous_iterator<RandomIt>::value) {
+        using T = typename std::iterator_traits<RandomIt>::value_type;
+        if (first == last) return sort_range<T *>(nullptr, nullptr);
+        T *data = &*first;
+        return sort_range<T *>(data, data + (last - first));
+    }
+    else {
+        return sort_range<RandomIt>(first, last);
+    }
+}
+
+//default comparator of the iterator overloads
+template<typename RandomIt>
+using iterator_less = std::less<typename std::iterator_traits<RandomIt>::value_type>;
+
+//instrumentation helper struct
+//operation counts shared by every copy of an instrumented comparator, copies on other threads included
+struct sort_counters {
+    std::atomic<std::size_t> comparisons{0};
+    std::atomic<std::size_t> swaps{0};
+    std::atomic<std::size_t> allocations{0};
+    std::atomic<std::size_t> max_depth{0};
+};
+
+//instrumentation helper struct
+//comparator wrapper counting every comparison into counters
+//the sorts take their comparator by value, so each recursive call owns a copy and
+//depth counts the recursion levels above the copy without any bookkeeping on return
+template<typename Compare>
+struct instrumented_compare {
+    Compare comp;
+    sort_counters *counters;
+    std::size_t depth = 0;
+
+    template<typename A, typename B>
+    bool operator()(const A &a, const B &b) const {
+        counters->comparisons.fetch_add(1, std::memory_order_relaxed);
+        return comp(a, b);
+    }
+};
+
+//instrumentation hooks, called by the sorts with their comparator:
+//they are empty unless the comparator is an instrumented_compare, so plain sorts pay nothing
+//count one element swap
+template<typename Compare>
+inline void count_swap(const Compare &) {}
+
+template<typename Compare>
+inline void count_swap(const instrumented_compare<Compare> &comp) {
+    comp.counters->swaps.fetch_add(1, std::memory_order_relaxed);
+}
+
+//count one scratch buffer allocation of the given number of elements, empty buffers do not allocate
+template<typename Compare>
+inline void count_allocation(const Compare &, std::size_t) {}
+
+template<typename Compare>
+inline void count_allocation(const instrumented_compare<Compare> &comp, std::size_t elements) {
+    if (elements > 0) comp.counters->allocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+//count entering one more level of recursion, called first thing by every recursive function
+template<typename Compare>
+inline void count_recursion(Compare &) {}
+
+template<typename Compare>
+inline void count_recursion(instrumented_compare<Compare> &comp) {
+    comp.depth ++;
+    std::size_t seen = comp.counters->max_depth.load(std::memory_order_relaxed);
+    while (seen < comp.depth && !comp.counters->max_depth.compare_exchange_weak(seen, comp.depth, std::memory_order_relaxed)) {}
+}
+
+//instrumentation helper function
+//push_back el onto a scratch buffer, counting the reallocation it causes
+template<typename T, typename U, typename Compare>
+void push_scratch(std::vector<T> &buffer, U &&el, const Compare &comp) {
+    if (buffer.size() == buffer.capacity()) count_allocation(comp, buffer.size() + 1);
+    buffer.push_back(std::forward<U>(el));
+}
+
+//swap helper function
+template<typename Range, typename Compare>
+void swap(Range &vector, std::size_t i, std::size_t j, const Compare &comp) {
     //swap the element at vector[i] and vector[j]
-    T temp = vector[i];
-    vector[i] = vector[j];
-    vector[j] = temp;
+    count_swap(comp);
+    std::swap(vector[i], vector[j]);
 }
 
-template<typename T, typename Compare>
-void bubble_sort(std::vector<T> &vector, Compare comp = std::less<T>()) {
+template<typename RandomIt, typename Compare = iterator_less<RandomIt>>
+void bubble_sort(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    auto vector = make_sort_range(first, last);
     // TODO: implement   
 
     if (vector.size() == 0 || vector.size() == 1) return;
@@ -24,7 +185,7 @@ void bubble_sort(std::vector<T> &vector, Compare comp = std::less<T>()) {
     for (std::size_t i = vector.size(); i > 0; i --) {
         for (std::size_t j = 0; j < i - 1; j ++) {
             if (comp(vector[j + 1], vector [j])) {
-                swap(vector, j, j + 1);
+                swap(vector, j, j + 1, comp);
             }
         }
     }
@@ -32,7 +193,13 @@ void bubble_sort(std::vector<T> &vector, Compare comp = std::less<T>()) {
 }
 
 template<typename T, typename Compare>
-void insertion_sort(std::vector<T> &vector, Compare comp = std::less<T>()) {
+void bubble_sort(std::vector<T> &vector, Compare comp = std::less<T>()) {
+    bubble_sort(vector.begin(), vector.end(), comp);
+}
+
+template<typename RandomIt, typename Compare = iterator_less<RandomIt>>
+void insertion_sort(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    auto vector = make_sort_range(first, last);
     // TODO: implement
 
     if (vector.size() == 0 || vector.size() == 1) return;
@@ -41,7 +208,7 @@ void insertion_sort(std::vector<T> &vector, Compare comp = std::less<T>()) {
         std::size_t j = i;
 
         while (j >= 0 && comp(vector[j + 1], vector[j])) {
-            swap(vector, j, j + 1);
+            swap(vector, j, j + 1, comp);
             if (j == 0) break;
             else j --;
         }
@@ -49,7 +216,14 @@ void insertion_sort(std::vector<T> &vector, Compare comp = std::less<T>()) {
 }
 
 template<typename T, typename Compare>
-void selection_sort(std::vector<T> &vector, Compare comp = std::less<T>()) {
+void insertion_sort(std::vector<T> &vector, Compare comp = std::less<T>()) {
+    insertion_sort(vector.begin(), vector.end(), comp);
+}
+
+template<typename RandomIt, typename Compare = iterator_less<RandomIt>>
+void selection_sort(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    auto vector = make_sort_range(first, last);
+    using T = range_value_t<decltype(vector)>;
     // TODO: implement
 
     if (vector.size() == 0 || vector.size() == 1) return;
@@ -64,17 +238,474 @@ void selection_sort(std::vector<T> &vector, Compare comp = std::less<T>()) {
                 min_el = vector[j];
             }
         }
-        if (min_index != i) swap(vector, min_index, i);
+        if (min_index != i) swap(vector, min_index, i, comp);
+    }
+}
+
+template<typename T, typename Compare>
+void selection_sort(std::vector<T> &vector, Compare comp = std::less<T>()) {
+    selection_sort(vector.begin(), vector.end(), comp);
+}
+
+//sorting networks
+//ranges of at most this many arithmetic elements can be sorted with a sorting network
+constexpr std::size_t SORT_NETWORK_MAX = 32;
+
+//sorting network helper
+//floor(log2(n)) usable in constant expressions
+constexpr std::size_t floor_log2_constexpr(std::size_t n) {
+    return n > 1 ? 1 + floor_log2_constexpr(n / 2) : 0;
+}
+
+//sort dispatch helper
+//true when comp is the natural ascending order of T
+template<typename T, typename Compare>
+struct is_natural_less : std::false_type {};
+template<typename T>
+struct is_natural_less<T, std::less<T>> : std::true_type {};
+template<typename T>
+struct is_natural_less<T, std::less<>> : std::true_type {};
+
+//sort dispatch helper
+//true when comp is the natural descending order of T
+template<typename T, typename Compare>
+struct is_natural_greater : std::false_type {};
+template<typename T>
+struct is_natural_greater<T, std::greater<T>> : std::true_type {};
+template<typename T>
+struct is_natural_greater<T, std::greater<>> : std::true_type {};
+
+//an instrumented comparator keeps the natural order of the one it wraps, so the radix, network and
+//SIMD paths stay the same when instrumented; those paths do not call comp and are not counted
+template<typename T, typename Compare>
+struct is_natural_less<T, instrumented_compare<Compare>> : is_natural_less<T, Compare> {};
+template<typename T, typename Compare>
+struct is_natural_greater<T, instrumented_compare<Compare>> : is_natural_greater<T, Compare> {};
+
+//sort dispatch helper
+//integers other than bool, and IEEE 754 float / double
+template<typename T>
+struct is_radix_sortable : std::integral_constant<bool,
+    (std::is_integral<T>::value && !std::is_same<T, bool>::value) ||
+    (std::is_floating_point<T>::value && std::numeric_limits<T>::is_iec559 && (sizeof(T) == 4 || sizeof(T) == 8))> {};
+
+//sorting network helper
+//true when [first, last) of T may be sorted by a sorting network instead of comp:
+//arithmetic elements in their natural order, where swapping equal keys is not observable
+template<typename T, typename Compare>
+struct use_sort_network : std::integral_constant<bool,
+    is_radix_sortable<T>::value && (is_natural_less<T, Compare>::value || is_natural_greater<T, Compare>::value)> {};
+
+//sorting network helper
+//element types with an AVX2 kernel: 8 lanes per 256 bit register
+template<typename T>
+struct is_simd_network_type : std::integral_constant<bool,
+    std::is_same<T, std::int32_t>::value || std::is_same<T, float>::value> {};
+
+//sorting network helper
+//comparators of the ascending bitonic sorting network on N elements, N a power of two:
+//after comparator (lo, hi), position lo holds the smaller and position hi the larger element
+template<std::size_t N>
+struct bitonic_network {
+    static constexpr std::size_t size = N * floor_log2_constexpr(N) * (floor_log2_constexpr(N) + 1) / 4;
+    std::size_t lo[size];
+    std::size_t hi[size];
+};
+
+template<std::size_t N>
+constexpr bitonic_network<N> make_bitonic_network() {
+    bitonic_network<N> network{};
+    std::size_t c = 0;
+    for (std::size_t k = 2; k <= N; k *= 2) {
+        for (std::size_t j = k / 2; j > 0; j /= 2) {
+            for (std::size_t i = 0; i < N; i ++) {
+                std::size_t partner = i ^ j;
+                if (partner <= i) continue;
+
+                bool ascending = (i & k) == 0; //blocks with bit k set are sorted descending
+                network.lo[c] = ascending ? i : partner;
+                network.hi[c] = ascending ? partner : i;
+                c ++;
+            }
+        }
+    }
+    return network;
+}
+
+template<std::size_t N>
+inline constexpr bitonic_network<N> BITONIC_NETWORK = make_bitonic_network<N>();
+
+//sorting network helper function
+//ascending bitonic sort of buf[0, N) for N a power of two,
+//every compare-exchange is one compare feeding two selects without branches, so it permutes the two elements
+//even when they compare equal (0.0 and -0.0), where a min / max pair would duplicate one of them
+template<std::size_t N, typename T>
+void bitonic_sort_scalar(T *buf) {
+    for (std::size_t c = 0; c < bitonic_network<N>::size; c ++) {
+        T a = buf[BITONIC_NETWORK<N>.lo[c]];
+        T b = buf[BITONIC_NETWORK<N>.hi[c]];
+        bool exchange = b < a;
+        buf[BITONIC_NETWORK<N>.lo[c]] = exchange ? b : a;
+        buf[BITONIC_NETWORK<N>.hi[c]] = exchange ? a : b;
+    }
+}
+
+#if defined(__AVX2__)
+//sorting network helper functions
+//the same 8 lane operations for int32_t (__m256i) and float (__m256)
+inline __m256i simd_load(const std::int32_t *ptr) { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr)); }
+inline __m256 simd_load(const float *ptr) { return _mm256_loadu_ps(ptr); }
+inline void simd_store(std::int32_t *ptr, __m256i v) { _mm256_storeu_si256(reinterpret_cast<__m256i *>(ptr), v); }
+inline void simd_store(float *ptr, __m256 v) { _mm256_storeu_ps(ptr, v); }
+inline __m256i simd_less(__m256i a, __m256i b) { return _mm256_cmpgt_epi32(b, a); }
+inline __m256i simd_less(__m256 a, __m256 b) { return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_LT_OQ)); }
+inline __m256i simd_permute(__m256i v, __m256i idx) { return _mm256_permutevar8x32_epi32(v, idx); }
+inline __m256 simd_permute(__m256 v, __m256i idx) { return _mm256_permutevar8x32_ps(v, idx); }
+inline __m256i simd_blend(__m256i a, __m256i b, __m256i mask) { return _mm256_blendv_epi8(a, b, mask); }
+inline __m256 simd_blend(__m256 a, __m256 b, __m256i mask) { return _mm256_blendv_ps(a, b, _mm256_castsi256_ps(mask)); }
+
+//sorting network helper function
+//compare-exchange lane by lane: lo gets the smaller and hi the larger lane of every pair, both selected by
+//one comparison, so lanes that compare equal (0.0 and -0.0) are exchanged as a pair and never duplicated
+template<typename V>
+inline void simd_compare_exchange(V &lo, V &hi) {
+    __m256i exchange = simd_less(hi, lo);
+    V smaller = simd_blend(lo, hi, exchange);
+    hi = simd_blend(hi, lo, exchange);
+    lo = smaller;
+}
+
+//sorting network helper
+//-1 when lane i keeps the maximum in the bitonic layer comparing lanes i and i ^ j
+//inside blocks of k lanes (blocks with bit k set are sorted descending)
+constexpr int bitonic_lane_max(int i, int j, int k) {
+    return (((i & j) != 0) != ((i & k) != 0)) ? -1 : 0;
+}
+
+//sorting network helper function
+//one compare-exchange layer of the bitonic network inside a register
+template<int J, int K, typename V>
+inline V bitonic_layer(V v) {
+    const __m256i idx = _mm256_setr_epi32(0 ^ J, 1 ^ J, 2 ^ J, 3 ^ J, 4 ^ J, 5 ^ J, 6 ^ J, 7 ^ J);
+    const __m256i take_max = _mm256_setr_epi32(bitonic_lane_max(0, J, K), bitonic_lane_max(1, J, K),
+                                               bitonic_lane_max(2, J, K), bitonic_lane_max(3, J, K),
+                                               bitonic_lane_max(4, J, K), bitonic_lane_max(5, J, K),
+                                               bitonic_lane_max(6, J, K), bitonic_lane_max(7, J, K));
+    V other = simd_permute(v, idx);
+    //a lane keeping the minimum takes its partner when the partner is smaller, and the partner lane, keeping the
+    //maximum, must then take it: the max lanes reuse the comparison of their partner instead of comparing again
+    __m256i smaller = simd_less(other, v);
+    __m256i exchange = simd_blend(smaller, simd_permute(smaller, idx), take_max);
+    return simd_blend(v, other, exchange);
+}
+
+template<typename V>
+inline V simd_reverse(V v) {
+    return simd_permute(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+}
+
+//sorting network helper function
+//sort the 8 lanes of v ascending
+template<typename V>
+inline V bitonic_sort8(V v) {
+    v = bitonic_layer<1, 2>(v);
+    v = bitonic_layer<2, 4>(v);
+    v = bitonic_layer<1, 4>(v);
+    v = bitonic_layer<4, 8>(v);
+    v = bitonic_layer<2, 8>(v);
+    return bitonic_layer<1, 8>(v);
+}
+
+//sorting network helper function
+//sort the bitonic sequence in the 8 lanes of v ascending
+template<typename V>
+inline V bitonic_merge8(V v) {
+    v = bitonic_layer<4, 8>(v);
+    v = bitonic_layer<2, 8>(v);
+    return bitonic_layer<1, 8>(v);
+}
+
+//sorting network helper function
+//sort the bitonic sequence held in (a, b) ascending
+template<typename V>
+inline void bitonic_merge16(V &a, V &b) {
+    simd_compare_exchange(a, b);
+    a = bitonic_merge8(a);
+    b = bitonic_merge8(b);
+}
+
+//sorting network helper function
+//sort the 16 lanes of (a, b) ascending
+template<typename V>
+inline void bitonic_sort16(V &a, V &b) {
+    a = bitonic_sort8(a);
+    b = simd_reverse(bitonic_sort8(b));
+    bitonic_merge16(a, b);
+}
+
+//sorting network helper function
+//sort the 32 lanes of (a, b, c, d) ascending
+template<typename V>
+inline void bitonic_sort32(V &a, V &b, V &c, V &d) {
+    bitonic_sort16(a, b);
+    bitonic_sort16(c, d);
+
+    //compare the first 16 lanes against the second 16 reversed
+    V hi1 = simd_reverse(d);
+    V hi2 = simd_reverse(c);
+    simd_compare_exchange(a, hi1);
+    simd_compare_exchange(b, hi2);
+    bitonic_merge16(a, b);
+    bitonic_merge16(hi1, hi2);
+    c = hi1;
+    d = hi2;
+}
+
+//sorting network helper function
+//ascending bitonic sort of buf[0, N), N in {8, 16, 32}, held entirely in registers
+template<std::size_t N, typename T>
+void bitonic_sort_simd(T *buf) {
+    if constexpr (N == 8) {
+        simd_store(buf, bitonic_sort8(simd_load(buf)));
+    }
+    else if constexpr (N == 16) {
+        auto a = simd_load(buf), b = simd_load(buf + 8);
+        bitonic_sort16(a, b);
+        simd_store(buf, a);
+        simd_store(buf + 8, b);
+    }
+    else {
+        auto a = simd_load(buf), b = simd_load(buf + 8), c = simd_load(buf + 16), d = simd_load(buf + 24);
+        bitonic_sort32(a, b, c, d);
+        simd_store(buf, a);
+        simd_store(buf + 8, b);
+        simd_store(buf + 16, c);
+        simd_store(buf + 24, d);
+    }
+}
+
+//vectorized partition helper
+//for every 8 bit lane mask, a permutation moving the set lanes to the front (in order)
+//and the clear lanes to the back
+struct partition_permutations {
+    std::int32_t idx[256][8];
+};
+
+constexpr partition_permutations make_partition_permutations() {
+    partition_permutations table{};
+    for (int mask = 0; mask < 256; mask ++) {
+        int k = 0;
+        for (int lane = 0; lane < 8; lane ++) {
+            if (mask & (1 << lane)) table.idx[mask][k ++] = lane;
+        }
+        for (int lane = 0; lane < 8; lane ++) {
+            if (!(mask & (1 << lane))) table.idx[mask][k ++] = lane;
+        }
+    }
+    return table;
+}
+
+inline constexpr partition_permutations PARTITION_PERMUTATIONS = make_partition_permutations();
+
+//vectorized partition helper function
+//lane mask of the elements of v that go before pivot under less (or greater)
+template<bool Less>
+inline int partition_mask(__m256i v, __m256i pivot) {
+    __m256i before = Less ? _mm256_cmpgt_epi32(pivot, v) : _mm256_cmpgt_epi32(v, pivot);
+    return _mm256_movemask_ps(_mm256_castsi256_ps(before));
+}
+
+template<bool Less>
+inline int partition_mask(__m256 v, __m256 pivot) {
+    return _mm256_movemask_ps(_mm256_cmp_ps(v, pivot, Less ? _CMP_LT_OQ : _CMP_GT_OQ));
+}
+
+inline __m256i simd_broadcast(std::int32_t el) { return _mm256_set1_epi32(el); }
+inline __m256 simd_broadcast(float el) { return _mm256_set1_ps(el); }
+
+//vectorized partition helper function
+//write the lanes of v going before the pivot at write_l and the others just below write_r
+template<bool Less, typename T, typename V>
+inline void partition_store(T *arr, V v, V pivot, std::ptrdiff_t &write_l, std::ptrdiff_t &write_r) {
+    int mask = partition_mask<Less>(v, pivot);
+    int before = __builtin_popcount((unsigned int)mask);
+    V packed = simd_permute(v, simd_load(PARTITION_PERMUTATIONS.idx[mask]));
+    simd_store(arr + write_l, packed);
+    simd_store(arr + write_r - 8, packed);
+    write_l += before;
+    write_r -= 8 - before;
+}
+
+//vectorized partition helper function
+//in place partition of arr[0, n), n >= 16, into elements before pivot and the rest
+//the first and last 8 elements are held in registers, leaving 16 free slots that always
+//sit where the next full vector store goes; each step reads 8 elements from the side with less free space
+//return the number of elements before pivot
+template<bool Less, typename T>
+std::size_t partition_simd(T *arr, std::size_t n, T pivot_el) {
+    using V = decltype(simd_load(arr));
+    V pivot = simd_broadcast(pivot_el);
+    V first_saved = simd_load(arr);
+    V last_saved = simd_load(arr + n - 8);
+
+    std::ptrdiff_t read_l = 8, read_r = (std::ptrdiff_t)n - 8;
+    std::ptrdiff_t write_l = 0, write_r = (std::ptrdiff_t)n;
+    while (read_r - read_l >= 8) {
+        V v;
+        if (read_l - write_l <= write_r - read_r) {
+            v = simd_load(arr + read_l);
+            read_l += 8;
+        }
+        else {
+            read_r -= 8;
+            v = simd_load(arr + read_r);
+        }
+        partition_store<Less>(arr, v, pivot, write_l, write_r);
+    }
+
+    //fewer than 8 left: place them one by one
+    while (read_l < read_r) {
+        T el;
+        if (read_l - write_l <= write_r - read_r) el = arr[read_l ++];
+        else el = arr[-- read_r];
+
+        if (Less ? el < pivot_el : pivot_el < el) arr[write_l ++] = el;
+        else arr[-- write_r] = el;
+    }
+
+    partition_store<Less>(arr, first_saved, pivot, write_l, write_r);
+    partition_store<Less>(arr, last_saved, pivot, write_l, write_r);
+    return (std::size_t)write_l;
+}
+#endif //__AVX2__
+
+//sorting network helper function
+//ascending sort of buf[0, N) for N in {8, 16, 32}, AVX2 kernels when available, scalar otherwise
+template<std::size_t N, typename T>
+void sort_network(T *buf) {
+#if defined(__AVX2__)
+    if constexpr (is_simd_network_type<T>::value) {
+        bitonic_sort_simd<N>(buf);
+        return;
+    }
+#endif
+    bitonic_sort_scalar<N>(buf);
+}
+
+//sorting network helper function
+//sort [first, last), at most SORT_NETWORK_MAX elements, by padding it with the largest value
+//of T up to the next network size; requires use_sort_network<T, Compare>
+template<typename Range, typename Compare>
+void network_sort_range(Range &vector, std::size_t first, std::size_t last, Compare) {
+    using T = range_value_t<Range>;
+    std::size_t n = last - first;
+    if (n < 2) return;
+
+    T buf[SORT_NETWORK_MAX];
+    std::copy(vector.begin() + (std::ptrdiff_t)first, vector.begin() + (std::ptrdiff_t)last, buf);
+    const T pad = std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max();
+    std::fill(buf + n, buf + SORT_NETWORK_MAX, pad);
+
+    if (n <= 8) sort_network<8>(buf);
+    else if (n <= 16) sort_network<16>(buf);
+    else sort_network<32>(buf);
+
+    if (is_natural_greater<T, Compare>::value) std::reverse_copy(buf, buf + n, vector.begin() + (std::ptrdiff_t)first);
+    else std::copy(buf, buf + n, vector.begin() + (std::ptrdiff_t)first);
+}
+
+//static sort
+//sorting network helper
+//comparators of the merge exchange sorting network on N elements (Knuth, algorithm 5.2.2M, after Batcher):
+//any N, and the fewest comparators possible up to N = 8
+//the same loops count the comparators for size and then fill lo / hi
+template<std::size_t N>
+constexpr std::size_t merge_exchange_network(std::size_t *lo, std::size_t *hi) {
+    std::size_t c = 0;
+    if (N < 2) return c;
+    std::size_t t = floor_log2_constexpr(N - 1) + 1; //ceil(log2(N))
+    for (std::size_t p = std::size_t(1) << (t - 1); p > 0; p /= 2) {
+        std::size_t q = std::size_t(1) << (t - 1), r = 0, d = p;
+        while (true) {
+            for (std::size_t i = 0; i + d < N; i ++) {
+                if ((i & p) != r) continue;
+                if (lo) {
+                    lo[c] = i;
+                    hi[c] = i + d;
+                }
+                c ++;
+            }
+            if (q == p) break;
+            d = q - p;
+            q /= 2;
+            r = p;
+        }
+    }
+    return c;
+}
+
+template<std::size_t N>
+struct static_network {
+    static constexpr std::size_t size = merge_exchange_network<N>(nullptr, nullptr);
+    std::size_t lo[size > 0 ? size : 1];
+    std::size_t hi[size > 0 ? size : 1];
+};
+
+template<std::size_t N>
+constexpr static_network<N> make_static_network() {
+    static_network<N> network{};
+    merge_exchange_network<N>(network.lo, network.hi);
+    return network;
+}
+
+template<std::size_t N>
+inline constexpr static_network<N> STATIC_NETWORK = make_static_network<N>();
+
+//sorting network helper function
+//compare-exchange arr[lo] and arr[hi] so that arr[lo] does not come after arr[hi]:
+//min / max without branches for arithmetic elements in their natural order, a conditional swap otherwise
+template<typename Array, typename Compare>
+constexpr void compare_exchange(Array &arr, std::size_t lo, std::size_t hi, Compare comp) {
+    using T = std::remove_cv_t<std::remove_reference_t<decltype(arr[0])>>;
+    if constexpr (use_sort_network<T, Compare>::value) {
+        T a = arr[lo], b = arr[hi];
+        bool exchange = is_natural_less<T, Compare>::value ? b < a : a < b; //one compare feeding two selects
+        arr[lo] = exchange ? b : a;
+        arr[hi] = exchange ? a : b;
+    }
+    else if (comp(arr[hi], arr[lo])) {
+        T tmp = std::move(arr[lo]); //std::swap is not constexpr before C++20
+        arr[lo] = std::move(arr[hi]);
+        arr[hi] = std::move(tmp);
     }
 }
 
+//sorting network helper function
+//apply every comparator of STATIC_NETWORK<N>, expanded into straight line code
+template<std::size_t N, typename Array, typename Compare, std::size_t... C>
+constexpr void static_sort_network(Array &arr, Compare comp, std::index_sequence<C...>) {
+    (compare_exchange(arr, STATIC_NETWORK<N>.lo[C], STATIC_NETWORK<N>.hi[C], comp), ...);
+}
+
+//sort the N elements of arr with a sorting network generated at compile time: no loops, no size checks,
+//and usable in constant expressions when T and comp are; not stable
+//meant for small N, the network has O(N log^2 N) comparators
+template<std::size_t N, typename T, typename Compare = std::less<T>>
+constexpr void static_sort(std::array<T, N> &arr, Compare comp = Compare()) {
+    static_sort_network<N>(arr, comp, std::make_index_sequence<static_network<N>::size>());
+}
+
+
 //mergesort helper function
 //sort and merge array
-template<typename T, typename Compare>
-void merge(std::vector<T> &arr, std::size_t l, std::size_t mid, std::size_t r, Compare comp = std::less<T>()) {
+template<typename Range, typename Compare>
+void merge(Range &arr, std::size_t l, std::size_t mid, std::size_t r, Compare comp = std::less<range_value_t<Range>>()) {
+    using T = range_value_t<Range>;
 
     std::vector<T> leftarray(mid - l + 1);
     std::vector<T> rightarray(r - mid);
+    count_allocation(comp, leftarray.size());
+    count_allocation(comp, rightarray.size());
 
     for (std::size_t i = 0; i < (mid - l + 1); i ++) {
         leftarray[i] = arr[l + i];
@@ -128,9 +759,17 @@ void merge(std::vector<T> &arr, std::size_t l, std::size_t mid, std::size_t r, C
 
 //mergesort helper function
 //split array
-template<typename T, typename Compare>
-void mergesort(std::vector<T> &vector, std::size_t l, std::size_t r, Compare comp = std::less<T>()) {
+template<typename Range, typename Compare>
+void mergesort(Range &vector, std::size_t l, std::size_t r, Compare comp = std::less<range_value_t<Range>>()) {
+    using T = range_value_t<Range>;
+    count_recursion(comp);
     if (l >= r) return; //end splitting
+    if constexpr (use_sort_network<T, Compare>::value) {
+        if (r - l < SORT_NETWORK_MAX) {
+            network_sort_range(vector, l, r + 1, comp);
+            return;
+        }
+    }
 
     std::size_t mid = l + (r - l) / 2;
     mergesort(vector, l, mid, comp);
@@ -139,8 +778,9 @@ void mergesort(std::vector<T> &vector, std::size_t l, std::size_t r, Compare com
 
 }
 
-template<typename T, typename Compare>
-void merge_sort(std::vector<T> &vector, Compare comp = std::less<T>()) {
+template<typename RandomIt, typename Compare = iterator_less<RandomIt>>
+void merge_sort(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    auto vector = make_sort_range(first, last);
     // TODO: implement
 
     if (vector.size() == 0 || vector.size() == 1) return;
@@ -148,32 +788,55 @@ void merge_sort(std::vector<T> &vector, Compare comp = std::less<T>()) {
     mergesort(vector, 0, vector.size() - 1, comp);
 }
 
+template<typename T, typename Compare>
+void merge_sort(std::vector<T> &vector, Compare comp = std::less<T>()) {
+    merge_sort(vector.begin(), vector.end(), comp);
+}
+
 
 //quicksort in place partition
 // helper function 
-template<typename T, typename Compare>
-std::size_t partition_inplace(std::vector<T> &vector, std::size_t low, std::size_t high, Compare comp = std::less<T>()) {
+template<typename Range, typename Compare>
+std::size_t partition_inplace(Range &vector, std::size_t low, std::size_t high, Compare comp = std::less<range_value_t<Range>>()) {
+    using T = range_value_t<Range>;
     T pivot_el = vector[high]; //choose pivot postd::size_t as the most right element first
+#if defined(__AVX2__)
+    if constexpr (is_simd_network_type<T>::value && use_sort_network<T, Compare>::value && is_contiguous_range<Range>::value) {
+        if (high - low >= 2 * SORT_NETWORK_MAX) {
+            std::size_t i = low + partition_simd<is_natural_less<T, Compare>::value>(&vector[low], high - low, pivot_el);
+            swap(vector, i, high, comp);
+            return i;
+        }
+    }
+#endif
     std::size_t i = low; 
 
     //i: start iteration and increment from the left most element, 
     //j: start iteration and decrement from the second right most element 
     for (std::size_t j = low; j < high; j ++) {
         if (comp(vector[j], pivot_el)) {
-            swap(vector, i, j);
+            swap(vector, i, j, comp);
             i ++;
         }
     }
 
-    swap(vector, i, high);
+    swap(vector, i, high, comp);
     return i;
 }
 
 //helper function
 //quick sort in place
-template<typename T, typename Compare>
-void quicksort_inplace(std::vector<T> &vector, std::size_t low, std::size_t high, Compare comp = std::less<T>()) {
+template<typename Range, typename Compare>
+void quicksort_inplace(Range &vector, std::size_t low, std::size_t high, Compare comp = std::less<range_value_t<Range>>()) {
+    using T = range_value_t<Range>;
+    count_recursion(comp);
     if (low >= high ) return; //end sorting 
+    if constexpr (use_sort_network<T, Compare>::value) {
+        if (high - low < SORT_NETWORK_MAX) {
+            network_sort_range(vector, low, high + 1, comp);
+            return;
+        }
+    }
 
     std::size_t pivot = partition_inplace(vector, low, high, comp); //return the index of the sorted pivot element
 
@@ -181,8 +844,9 @@ void quicksort_inplace(std::vector<T> &vector, std::size_t low, std::size_t high
     if (pivot < vector.size()) quicksort_inplace(vector, pivot + 1, high, comp);
 }
 
-template<typename T, typename Compare>
-void quick_sort_inplace(std::vector<T> &vector, Compare comp = std::less<T>()) {
+template<typename RandomIt, typename Compare = iterator_less<RandomIt>>
+void quick_sort_inplace(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    auto vector = make_sort_range(first, last);
     // TODO: implement
 
     if (vector.size() == 0 || vector.size() == 1) return;
@@ -190,10 +854,16 @@ void quick_sort_inplace(std::vector<T> &vector, Compare comp = std::less<T>()) {
     quicksort_inplace(vector, 0, vector.size() - 1, comp);
 }
 
+template<typename T, typename Compare>
+void quick_sort_inplace(std::vector<T> &vector, Compare comp = std::less<T>()) {
+    quick_sort_inplace(vector.begin(), vector.end(), comp);
+}
+
 //quicksort extra place 
 //helper function 
-template<typename T, typename Compare>
-std::size_t partition_extra(std::vector<T> &arr, std::size_t low, std::size_t high, Compare comp = std::less<T>()) {
+template<typename Range, typename Compare>
+std::size_t partition_extra(Range &arr, std::size_t low, std::size_t high, Compare comp = std::less<range_value_t<Range>>()) {
+    using T = range_value_t<Range>;
     T pivot_el = arr[high]; //choose pivot point as the most right element first
 
 
@@ -202,10 +872,10 @@ std::size_t partition_extra(std::vector<T> &arr, std::size_t low, std::size_t hi
 
     for (std::size_t i = low; i < high; i ++) {
         if (comp(arr[i], pivot_el)){
-            less.push_back(arr[i]);
+            push_scratch(less, arr[i], comp);
         }
         else {
-            greater.push_back(arr[i]);
+            push_scratch(greater, arr[i], comp);
         }
     }
 
@@ -224,8 +894,9 @@ std::size_t partition_extra(std::vector<T> &arr, std::size_t low, std::size_t hi
 
 //quicksort_extra
 //helper function
-template<typename T, typename Compare>
-void quicksort_extra(std::vector<T> &vector, std::size_t low, std::size_t high, Compare comp = std::less<T>()) {
+template<typename Range, typename Compare>
+void quicksort_extra(Range &vector, std::size_t low, std::size_t high, Compare comp = std::less<range_value_t<Range>>()) {
+    count_recursion(comp);
 
     if (low >= high) return;
 
@@ -235,14 +906,2481 @@ void quicksort_extra(std::vector<T> &vector, std::size_t low, std::size_t high,
     if (pivot < vector.size()) quicksort_extra(vector, pivot + 1, high, comp);
 }
 
-template<typename T, typename Compare>
-void quick_sort_extra(std::vector<T> &vector, Compare comp = std::less<T>()) {
+template<typename RandomIt, typename Compare = iterator_less<RandomIt>>
+void quick_sort_extra(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    auto vector = make_sort_range(first, last);
     // TODO: implement
     if (vector.size() == 0 || vector.size() == 1) return;
 
     quicksort_extra(vector, 0, vector.size() - 1, comp);
 }
 
+template<typename T, typename Compare>
+void quick_sort_extra(std::vector<T> &vector, Compare comp = std::less<T>()) {
+    quick_sort_extra(vector.begin(), vector.end(), comp);
+}
+
+
+
+//introsort
+//partitions smaller than this are finished with insertion sort
+constexpr std::size_t INSERTION_SORT_THRESHOLD = 16;
+
+//introsort helper function
+//return floor(log2(n)), used to bound the recursion depth
+inline std::size_t floor_log2(std::size_t n) {
+    std::size_t log = 0;
+    while (n > 1) {
+        n >>= 1;
+        log ++;
+    }
+    return log;
+}
+
+//introsort helper function
+//insertion sort on the half-open range [first, last), shifting by move instead of swapping
+template<typename Range, typename Compare>
+void insertion_sort_range(Range &vector, std::size_t first, std::size_t last, Compare comp = std::less<range_value_t<Range>>()) {
+    using T = range_value_t<Range>;
+    for (std::size_t i = first + 1; i < last; i ++) {
+        T el = std::move(vector[i]);
+        std::size_t j = i;
+        while (j > first && comp(el, vector[j - 1])) {
+            vector[j] = std::move(vector[j - 1]);
+            j --;
+        }
+        vector[j] = std::move(el);
+    }
+}
+
+//introsort helper function
+//sort a small range [first, last): sorting network for arithmetic elements in natural order,
+//insertion sort otherwise
+template<typename Range, typename Compare>
+void small_sort(Range &vector, std::size_t first, std::size_t last, Compare comp = std::less<range_value_t<Range>>()) {
+    using T = range_value_t<Range>;
+    if constexpr (use_sort_network<T, Compare>::value) {
+        if (last - first <= SORT_NETWORK_MAX) {
+            network_sort_range(vector, first, last, comp);
+            return;
+        }
+    }
+    insertion_sort_range(vector, first, last, comp);
+}
+
+//introsort helper function
+//return the index of the median of vector[a], vector[b] and vector[c]
+template<typename Range, typename Compare>
+std::size_t median_of_three(const Range &vector, std::size_t a, std::size_t b, std::size_t c, Compare comp = std::less<range_value_t<Range>>()) {
+    if (comp(vector[a], vector[b])) {
+        if (comp(vector[b], vector[c])) return b; //a < b < c
+        return comp(vector[a], vector[c]) ? c : a; //a < b, c <= b
+    }
+    if (comp(vector[a], vector[c])) return a; //b <= a < c
+    return comp(vector[b], vector[c]) ? c : b; //b <= a, c <= a
+}
+
+//introsort helper function
+//choose the pivot index of [first, last): median of three for small ranges,
+//Tukey's ninther (median of three medians) for large ranges
+template<typename Range, typename Compare>
+std::size_t choose_pivot(const Range &vector, std::size_t first, std::size_t last, Compare comp = std::less<range_value_t<Range>>()) {
+    std::size_t n = last - first;
+    std::size_t mid = first + n / 2;
+    if (n > 128) {
+        std::size_t step = n / 8;
+        std::size_t m1 = median_of_three(vector, first, first + step, first + 2 * step, comp);
+        std::size_t m2 = median_of_three(vector, mid - step, mid, mid + step, comp);
+        std::size_t m3 = median_of_three(vector, last - 1 - 2 * step, last - 1 - step, last - 1, comp);
+        return median_of_three(vector, m1, m2, m3, comp);
+    }
+    return median_of_three(vector, first, mid, last - 1, comp);
+}
+
+//introsort helper function
+//finish a hoare partition whose pivot sits at vector[first], with [first + 1, i) already
+//no greater and (j, last) already no less than the pivot; [i, j] is still unpartitioned
+//elements equal to the pivot stop both scans, so runs of equal keys are split evenly
+//move the pivot to its final index and return it
+template<typename Range, typename Compare>
+std::size_t hoare_partition_finish(Range &vector, std::size_t first, std::size_t i, std::size_t j, Compare comp = std::less<range_value_t<Range>>()) {
+    while (true) {
+        while (i <= j && comp(vector[i], vector[first])) i ++;
+        while (i <= j && comp(vector[first], vector[j])) j --;
+        if (i >= j) break;
+        swap(vector, i, j, comp);
+        i ++;
+        j --;
+    }
+
+    swap(vector, first, j, comp);
+    return j;
+}
+
+//introsort helper function
+//hoare partition of [first, last) around the chosen pivot
+//return the final index of the pivot
+template<typename Range, typename Compare>
+std::size_t partition_pivot(Range &vector, std::size_t first, std::size_t last, Compare comp = std::less<range_value_t<Range>>()) {
+    swap(vector, first, choose_pivot(vector, first, last, comp), comp); //keep the pivot at first while scanning
+
+    return hoare_partition_finish(vector, first, first + 1, last - 1, comp);
+}
+
+//block quicksort
+//number of elements scanned per block on each side
+constexpr std::size_t PARTITION_BLOCK_SIZE = 128;
+
+//block quicksort helper function
+//hoare partition of [first, last) that first records the offsets of misplaced elements of a left
+//and a right block into small buffers, with the comparison result added to the buffer length
+//instead of branched on, then swaps the recorded pairs in bulk
+//the remaining middle of fewer than 2 * PARTITION_BLOCK_SIZE elements is finished by the scalar scan
+//return the final index of the pivot
+template<typename Range, typename Compare>
+std::size_t partition_block(Range &vector, std::size_t first, std::size_t last, Compare comp = std::less<range_value_t<Range>>()) {
+    using T = range_value_t<Range>;
+    swap(vector, first, choose_pivot(vector, first, last, comp), comp); //keep the pivot at first while scanning
+    const T &pivot_el = vector[first];
+
+    unsigned char offsets_l[PARTITION_BLOCK_SIZE];
+    unsigned char offsets_r[PARTITION_BLOCK_SIZE];
+    std::size_t start_l = 0, num_l = 0; //pending offsets in the current left block
+    std::size_t start_r = 0, num_r = 0; //pending offsets in the current right block
+
+    //unpartitioned range is [l, r], the left block is [l, l + B) and the right block (r - B, r]
+    std::size_t l = first + 1;
+    std::size_t r = last - 1;
+    while (r - l + 1 > 2 * PARTITION_BLOCK_SIZE) {
+        if (num_l == 0) {
+            start_l = 0;
+            for (std::size_t i = 0; i < PARTITION_BLOCK_SIZE; i ++) {
+                offsets_l[num_l] = (unsigned char)i;
+                num_l += !comp(vector[l + i], pivot_el); //belongs right of the pivot
+            }
+        }
+        if (num_r == 0) {
+            start_r = 0;
+            for (std::size_t i = 0; i < PARTITION_BLOCK_SIZE; i ++) {
+                offsets_r[num_r] = (unsigned char)i;
+                num_r += !comp(pivot_el, vector[r - i]); //belongs left of the pivot
+            }
+        }
+
+        std::size_t num = std::min(num_l, num_r);
+        for (std::size_t k = 0; k < num; k ++) {
+            swap(vector, l + offsets_l[start_l + k], r - offsets_r[start_r + k], comp);
+        }
+        num_l -= num;
+        num_r -= num;
+        start_l += num;
+        start_r += num;
+
+        if (num_l == 0) l += PARTITION_BLOCK_SIZE;
+        if (num_r == 0) r -= PARTITION_BLOCK_SIZE;
+    }
+
+    //everything outside [l, r] is in place, a block with pending offsets is simply scanned again
+    return hoare_partition_finish(vector, first, l, r, comp);
+}
+
+//introsort helper
+//partition policies for introsort_loop
+struct hoare_partitioner {
+    template<typename Range, typename Compare>
+    std::size_t operator()(Range &vector, std::size_t first, std::size_t last, Compare comp) const {
+        return partition_pivot(vector, first, last, comp);
+    }
+};
+
+struct block_partitioner {
+    template<typename Range, typename Compare>
+    std::size_t operator()(Range &vector, std::size_t first, std::size_t last, Compare comp) const {
+        return partition_block(vector, first, last, comp);
+    }
+};
+
+//heapsort helper function
+//sift vector[first + root] down the max heap stored in [first, first + len)
+template<typename Range, typename Compare>
+void sift_down(Range &vector, std::size_t first, std::size_t root, std::size_t len, Compare comp = std::less<range_value_t<Range>>()) {
+    using T = range_value_t<Range>;
+    T el = std::move(vector[first + root]);
+    while (2 * root + 1 < len) {
+        std::size_t child = 2 * root + 1;
+        if (child + 1 < len && comp(vector[first + child], vector[first + child + 1])) child ++;
+        if (!comp(el, vector[first + child])) break;
+        vector[first + root] = std::move(vector[first + child]);
+        root = child;
+    }
+    vector[first + root] = std::move(el);
+}
+
+//heapsort helper function
+//heap sort on the half-open range [first, last)
+template<typename Range, typename Compare>
+void heap_sort_range(Range &vector, std::size_t first, std::size_t last, Compare comp = std::less<range_value_t<Range>>()) {
+    std::size_t len = last - first;
+    if (len < 2) return;
+
+    for (std::size_t i = len / 2; i > 0; i --) {
+        sift_down(vector, first, i - 1, len, comp);
+    }
+    for (std::size_t end = len - 1; end > 0; end --) {
+        swap(vector, first, first + end, comp); //move the current maximum behind the heap
+        sift_down(vector, first, 0, end, comp);
+    }
+}
+
+template<typename RandomIt, typename Compare = iterator_less<RandomIt>>
+void heap_sort(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    auto vector = make_sort_range(first, last);
+    if (vector.size() == 0 || vector.size() == 1) return;
+
+    heap_sort_range(vector, 0, vector.size(), comp);
+}
+
+template<typename T, typename Compare>
+void heap_sort(std::vector<T> &vector, Compare comp = std::less<T>()) {
+    heap_sort(vector.begin(), vector.end(), comp);
+}
+
+//introsort helper function
+//quicksort [first, last) until the depth limit runs out, then fall back to heap sort
+//recurse into the smaller side only and loop on the larger one, so the stack depth stays O(log n)
+template<typename Range, typename Compare, typename Partition = hoare_partitioner>
+void introsort_loop(Range &vector, std::size_t first, std::size_t last, std::size_t depth_limit, Compare comp = std::less<range_value_t<Range>>(), Partition partition = Partition()) {
+    count_recursion(comp);
+    while (last - first > INSERTION_SORT_THRESHOLD) {
+        if (depth_limit == 0) {
+            heap_sort_range(vector, first, last, comp);
+            return;
+        }
+        depth_limit --;
+
+        std::size_t pivot = partition(vector, first, last, comp);
+        if (pivot - first < last - pivot - 1) {
+            introsort_loop(vector, first, pivot, depth_limit, comp, partition);
+            first = pivot + 1;
+        }
+        else {
+            introsort_loop(vector, pivot + 1, last, depth_limit, comp, partition);
+            last = pivot;
+        }
+    }
+    small_sort(vector, first, last, comp);
+}
+
+//quick sort with median-of-three/ninther pivots, insertion sort for small partitions
+//and a heap sort fallback once the recursion depth exceeds 2 * log2(n)
+template<typename RandomIt, typename Compare = iterator_less<RandomIt>>
+void quick_sort_intro(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    auto vector = make_sort_range(first, last);
+    if (vector.size() == 0 || vector.size() == 1) return;
 
+    introsort_loop(vector, 0, vector.size(), 2 * floor_log2(vector.size()), comp);
+}
+
+template<typename T, typename Compare>
+void quick_sort_intro(std::vector<T> &vector, Compare comp = std::less<T>()) {
+    quick_sort_intro(vector.begin(), vector.end(), comp);
+}
+
+//introsort with block partitioning: the partition loop has no data dependent branches,
+//which pays off on random data where the comparison outcome cannot be predicted
+template<typename RandomIt, typename Compare = iterator_less<RandomIt>>
+void quick_sort_block(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    auto vector = make_sort_range(first, last);
+    if (vector.size() == 0 || vector.size() == 1) return;
+
+    introsort_loop(vector, 0, vector.size(), 2 * floor_log2(vector.size()), comp, block_partitioner());
+}
+
+template<typename T, typename Compare>
+void quick_sort_block(std::vector<T> &vector, Compare comp = std::less<T>()) {
+    quick_sort_block(vector.begin(), vector.end(), comp);
+}
+
+
+//three way quicksort helper function
+//dutch national flag partition of [first, last) around the chosen pivot in a single pass
+//afterwards [first, lt) < pivot, [lt, gt) == pivot and [gt, last) > pivot
+//return the pair (lt, gt)
+template<typename Range, typename Compare>
+std::pair<std::size_t, std::size_t> partition_3way(Range &vector, std::size_t first, std::size_t last, Compare comp = std::less<range_value_t<Range>>()) {
+    using T = range_value_t<Range>;
+    T pivot_el = vector[choose_pivot(vector, first, last, comp)];
+
+    std::size_t lt = first; //end of the block smaller than the pivot
+    std::size_t i = first; //next element to classify
+    std::size_t gt = last; //start of the block greater than the pivot
+    while (i < gt) {
+        if (comp(vector[i], pivot_el)) {
+            swap(vector, lt, i, comp);
+            lt ++;
+            i ++;
+        }
+        else if (comp(pivot_el, vector[i])) {
+            gt --;
+            swap(vector, i, gt, comp);
+        }
+        else {
+            i ++;
+        }
+    }
+
+    return {lt, gt};
+}
+
+//three way quicksort helper function
+//same loop as introsort_loop, but the block of keys equal to the pivot is never recursed into
+template<typename Range, typename Compare>
+void quicksort_3way(Range &vector, std::size_t first, std::size_t last, std::size_t depth_limit, Compare comp = std::less<range_value_t<Range>>()) {
+    count_recursion(comp);
+    while (last - first > INSERTION_SORT_THRESHOLD) {
+        if (depth_limit == 0) {
+            heap_sort_range(vector, first, last, comp);
+            return;
+        }
+        depth_limit --;
+
+        std::pair<std::size_t, std::size_t> bounds = partition_3way(vector, first, last, comp);
+        if (bounds.first - first < last - bounds.second) {
+            quicksort_3way(vector, first, bounds.first, depth_limit, comp);
+            first = bounds.second;
+        }
+        else {
+            quicksort_3way(vector, bounds.second, last, depth_limit, comp);
+            last = bounds.first;
+        }
+    }
+    small_sort(vector, first, last, comp);
+}
+
+//quick sort with a three way (fat) partition, for inputs with many duplicate keys
+template<typename RandomIt, typename Compare = iterator_less<RandomIt>>
+void quick_sort_3way(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    auto vector = make_sort_range(first, last);
+    if (vector.size() == 0 || vector.size() == 1) return;
+
+    quicksort_3way(vector, 0, vector.size(), 2 * floor_log2(vector.size()), comp);
+}
+
+template<typename T, typename Compare>
+void quick_sort_3way(std::vector<T> &vector, Compare comp = std::less<T>()) {
+    quick_sort_3way(vector.begin(), vector.end(), comp);
+}
+
+//three way quicksort extra place
+//helper function
+//move [first, last) out into less / equal / greater buffers and back
+//return the pair (lt, gt) bounding the keys equal to the pivot
+template<typename Range, typename Compare>
+std::pair<std::size_t, std::size_t> partition_extra_3way(Range &arr, std::size_t first, std::size_t last, Compare comp = std::less<range_value_t<Range>>()) {
+    using T = range_value_t<Range>;
+    T pivot_el = arr[choose_pivot(arr, first, last, comp)];
+
+    std::vector<T> less;
+    std::vector<T> equal;
+    std::vector<T> greater;
+
+    for (std::size_t i = first; i < last; i ++) {
+        if (comp(arr[i], pivot_el)) {
+            push_scratch(less, std::move(arr[i]), comp);
+        }
+        else if (comp(pivot_el, arr[i])) {
+            push_scratch(greater, std::move(arr[i]), comp);
+        }
+        else {
+            push_scratch(equal, std::move(arr[i]), comp);
+        }
+    }
+
+    std::size_t k = first;
+    for (auto &el:less) arr[k ++] = std::move(el);
+    for (auto &el:equal) arr[k ++] = std::move(el);
+    for (auto &el:greater) arr[k ++] = std::move(el);
+
+    return {first + less.size(), first + less.size() + equal.size()};
+}
+
+//three way quicksort_extra
+//helper function
+template<typename Range, typename Compare>
+void quicksort_extra_3way(Range &vector, std::size_t first, std::size_t last, Compare comp = std::less<range_value_t<Range>>()) {
+    count_recursion(comp);
+    while (last - first > 1) {
+        std::pair<std::size_t, std::size_t> bounds = partition_extra_3way(vector, first, last, comp);
+        if (bounds.first - first < last - bounds.second) {
+            quicksort_extra_3way(vector, first, bounds.first, comp);
+            first = bounds.second;
+        }
+        else {
+            quicksort_extra_3way(vector, bounds.second, last, comp);
+            last = bounds.first;
+        }
+    }
+}
+
+template<typename RandomIt, typename Compare = iterator_less<RandomIt>>
+void quick_sort_extra_3way(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    auto vector = make_sort_range(first, last);
+    if (vector.size() == 0 || vector.size() == 1) return;
+
+    quicksort_extra_3way(vector, 0, vector.size(), comp);
+}
+
+template<typename T, typename Compare>
+void quick_sort_extra_3way(std::vector<T> &vector, Compare comp = std::less<T>()) {
+    quick_sort_extra_3way(vector.begin(), vector.end(), comp);
+}
+
+
+//buffered merge sort
+//runs of this length are sorted with insertion sort before the bottom-up merge passes
+constexpr std::size_t MERGE_RUN_LENGTH = 32;
+
+//buffered merge sort helper function
+//merge the sorted ranges [l, mid) and [mid, r), moving the shorter one out into buffer
+//buffer is a std::vector or a sort_range and must hold at least min(mid - l, r - mid) elements
+template<typename Range, typename Buffer, typename Compare>
+void merge_buffered(Range &arr, std::size_t l, std::size_t mid, std::size_t r, Buffer &buffer, Compare comp = std::less<range_value_t<Range>>()) {
+    if (!comp(arr[mid], arr[mid - 1])) return; //the two runs are already in order
+
+    if (mid - l <= r - mid) {
+        //move the left run out and merge front to back
+        std::size_t len = mid - l;
+        for (std::size_t i = 0; i < len; i ++) buffer[i] = std::move(arr[l + i]);
+
+        std::size_t i = 0, j = mid, k = l;
+        while (i < len && j < r) {
+            //take from the left run on ties to keep the sort stable
+            if (comp(arr[j], buffer[i])) arr[k ++] = std::move(arr[j ++]);
+            else arr[k ++] = std::move(buffer[i ++]);
+        }
+        while (i < len) arr[k ++] = std::move(buffer[i ++]); //the rest of the right run is already in place
+    }
+    else {
+        //move the right run out and merge back to front
+        std::size_t len = r - mid;
+        for (std::size_t j = 0; j < len; j ++) buffer[j] = std::move(arr[mid + j]);
+
+        std::size_t i = mid, j = len, k = r;
+        while (i > l && j > 0) {
+            //take from the right run on ties to keep the sort stable
+            if (comp(buffer[j - 1], arr[i - 1])) arr[-- k] = std::move(arr[-- i]);
+            else arr[-- k] = std::move(buffer[-- j]);
+        }
+        while (j > 0) arr[-- k] = std::move(buffer[-- j]); //the rest of the left run is already in place
+    }
+}
+
+//buffered merge sort helper function
+//bottom-up merge sort of [first, last), buffer must hold at least (last - first) / 2 elements
+template<typename Range, typename Buffer, typename Compare>
+void mergesort_buffered(Range &vector, std::size_t first, std::size_t last, Buffer &buffer, Compare comp = std::less<range_value_t<Range>>()) {
+    std::size_t n = last - first;
+
+    for (std::size_t lo = first; lo < last; lo += MERGE_RUN_LENGTH) {
+        small_sort(vector, lo, std::min(lo + MERGE_RUN_LENGTH, last), comp);
+    }
+
+    for (std::size_t width = MERGE_RUN_LENGTH; width < n; width *= 2) {
+        for (std::size_t lo = first; lo < last - width; lo += 2 * width) {
+            merge_buffered(vector, lo, lo + width, std::min(lo + 2 * width, last), buffer, comp);
+        }
+    }
+}
+
+//stable bottom-up merge sort using a caller provided scratch buffer
+//buffer is grown to (last - first) / 2 if it is smaller, and is the only allocation made
+template<typename RandomIt, typename Compare = iterator_less<RandomIt>>
+void merge_sort_buffered(RandomIt first, RandomIt last, std::vector<typename std::iterator_traits<RandomIt>::value_type> &buffer, Compare comp = Compare()) {
+    auto vector = make_sort_range(first, last);
+    if (vector.size() == 0 || vector.size() == 1) return;
+    if (buffer.size() < vector.size() / 2) {
+        count_allocation(comp, vector.size() / 2);
+        buffer.resize(vector.size() / 2);
+    }
+
+    mergesort_buffered(vector, 0, vector.size(), buffer, comp);
+}
+
+template<typename T, typename Compare>
+void merge_sort_buffered(std::vector<T> &vector, std::vector<T> &buffer, Compare comp = std::less<T>()) {
+    merge_sort_buffered(vector.begin(), vector.end(), buffer, comp);
+}
+
+//stable bottom-up merge sort that allocates a single n / 2 scratch buffer
+template<typename RandomIt, typename Compare = iterator_less<RandomIt>>
+void merge_sort_buffered(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    std::vector<typename std::iterator_traits<RandomIt>::value_type> buffer((std::size_t)(last - first) / 2);
+    count_allocation(comp, buffer.size());
+    merge_sort_buffered(first, last, buffer, comp);
+}
+
+template<typename T, typename Compare>
+void merge_sort_buffered(std::vector<T> &vector, Compare comp = std::less<T>()) {
+    merge_sort_buffered(vector.begin(), vector.end(), comp);
+}
+
+//in place merge sort
+//in place merge sort helper function
+//stable merge of the sorted ranges [l, mid) and [mid, r) with a scratch buffer of any size, possibly empty:
+//while the shorter run does not fit in buffer, the longer run is split at its middle, the split point is
+//binary searched in the other run and the two inner pieces are swapped by a rotation, leaving two
+//independent smaller merges; the smaller one is recursed into and the larger one looped on
+template<typename Range, typename Compare>
+void merge_inplace(Range &arr, std::size_t l, std::size_t mid, std::size_t r, std::vector<range_value_t<Range>> &buffer, Compare comp = std::less<range_value_t<Range>>()) {
+    count_recursion(comp);
+    while (l < mid && mid < r && comp(arr[mid], arr[mid - 1])) {
+        if (std::min(mid - l, r - mid) <= buffer.size()) {
+            merge_buffered(arr, l, mid, r, buffer, comp);
+            return;
+        }
+
+        std::size_t cut_l, cut_r;
+        if (mid - l >= r - mid) {
+            //elements of the right run equal to arr[cut_l] stay behind it
+            cut_l = l + (mid - l) / 2;
+            cut_r = (std::size_t)(std::lower_bound(arr.begin() + (std::ptrdiff_t)mid, arr.begin() + (std::ptrdiff_t)r, arr[cut_l], comp) - arr.begin());
+        }
+        else {
+            //elements of the left run equal to arr[cut_r] stay in front of it
+            cut_r = mid + (r - mid) / 2;
+            cut_l = (std::size_t)(std::upper_bound(arr.begin() + (std::ptrdiff_t)l, arr.begin() + (std::ptrdiff_t)mid, arr[cut_r], comp) - arr.begin());
+        }
+        std::rotate(arr.begin() + (std::ptrdiff_t)cut_l, arr.begin() + (std::ptrdiff_t)mid, arr.begin() + (std::ptrdiff_t)cut_r);
+        std::size_t new_mid = cut_l + (cut_r - mid);
+
+        if (new_mid - l <= r - new_mid) {
+            merge_inplace(arr, l, cut_l, new_mid, buffer, comp);
+            l = new_mid;
+            mid = cut_r;
+        }
+        else {
+            merge_inplace(arr, new_mid, cut_r, r, buffer, comp);
+            r = new_mid;
+            mid = cut_l;
+        }
+    }
+}
+
+//in place merge sort helper function
+//bottom-up merge sort of [first, last) merging through merge_inplace
+template<typename Range, typename Compare>
+void mergesort_inplace(Range &vector, std::size_t first, std::size_t last, std::vector<range_value_t<Range>> &buffer, Compare comp = std::less<range_value_t<Range>>()) {
+    std::size_t n = last - first;
+
+    for (std::size_t lo = first; lo < last; lo += MERGE_RUN_LENGTH) {
+        small_sort(vector, lo, std::min(lo + MERGE_RUN_LENGTH, last), comp);
+    }
+
+    for (std::size_t width = MERGE_RUN_LENGTH; width < n; width *= 2) {
+        for (std::size_t lo = first; lo < last - width; lo += 2 * width) {
+            merge_inplace(vector, lo, lo + width, std::min(lo + 2 * width, last), buffer, comp);
+        }
+    }
+}
+
+//stable merge sort for memory capped callers, using at most memory_budget bytes of scratch space:
+//merges whose shorter run fits in the budget go through the buffer, longer ones are split by rotations
+//a budget of 0 needs O(1) extra memory and O(n log^2 n) time, a budget of n / 2 elements
+//is as fast as merge_sort_buffered; in between, every doubling of the budget saves a level of rotations
+template<typename RandomIt, typename Compare>
+void merge_sort_inplace(RandomIt first, RandomIt last, Compare comp, std::size_t memory_budget) {
+    auto vector = make_sort_range(first, last);
+    using T = range_value_t<decltype(vector)>;
+    if (vector.size() == 0 || vector.size() == 1) return;
+
+    std::vector<T> buffer(std::min(memory_budget / sizeof(T), vector.size() / 2));
+    count_allocation(comp, buffer.size());
+    mergesort_inplace(vector, 0, vector.size(), buffer, comp);
+}
+
+//stable merge sort with a scratch buffer of about sqrt(n) elements
+template<typename RandomIt, typename Compare = iterator_less<RandomIt>>
+void merge_sort_inplace(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    std::size_t n = (std::size_t)(last - first);
+    std::size_t root = (std::size_t)1 << ((floor_log2(n) + 1) / 2);
+    merge_sort_inplace(first, last, comp, root * sizeof(typename std::iterator_traits<RandomIt>::value_type));
+}
+
+template<typename T, typename Compare>
+void merge_sort_inplace(std::vector<T> &vector, Compare comp, std::size_t memory_budget) {
+    merge_sort_inplace(vector.begin(), vector.end(), comp, memory_budget);
+}
+
+template<typename T, typename Compare>
+void merge_sort_inplace(std::vector<T> &vector, Compare comp = std::less<T>()) {
+    merge_sort_inplace(vector.begin(), vector.end(), comp);
+}
+
+
+//parallel sorts
+//they fork with std::thread, so link with -pthread
+//subranges at or below this size are sorted sequentially
+constexpr std::size_t PARALLEL_GRAIN_SIZE = 1 << 15;
+
+//parallel sort helper function
+//number of hardware threads, at least 1
+//queried once, hardware_concurrency costs microseconds and would dominate small parallel sorts
+inline std::size_t default_thread_count() {
+    static const std::size_t threads = std::max(std::thread::hardware_concurrency(), 1u);
+    return threads;
+}
+
+//parallel sort helper function
+//number of fork levels allowed so that at most `threads` tasks run at once
+inline std::size_t fork_depth_for(std::size_t threads) {
+    std::size_t depth = floor_log2(threads);
+    if ((std::size_t(1) << depth) < threads) depth ++; //round up for non power of two counts
+    return depth;
+}
+
+//parallel quicksort helper function
+//partition [first, last) and fork one side onto a new thread while fork_depth lasts,
+//then finish with the sequential introsort
+template<typename Range, typename Compare>
+void quicksort_parallel(Range &vector, std::size_t first, std::size_t last, std::size_t fork_depth, std::size_t grain, Compare comp = std::less<range_value_t<Range>>()) {
+    count_recursion(comp);
+    std::size_t depth_limit = 2 * floor_log2(last - first);
+    while (fork_depth > 0 && depth_limit > 0 && last - first > grain) {
+        depth_limit --;
+
+        std::size_t pivot = partition_pivot(vector, first, last, comp);
+        std::size_t left = pivot - first;
+        std::size_t right = last - pivot - 1;
+        if (std::min(left, right) <= grain) {
+            //not worth a thread: sort the small side here and keep splitting the large side
+            if (left < right) {
+                introsort_loop(vector, first, pivot, 2 * floor_log2(left + 1), comp);
+                first = pivot + 1;
+            }
+            else {
+                introsort_loop(vector, pivot + 1, last, 2 * floor_log2(right + 1), comp);
+                last = pivot;
+            }
+            continue;
+        }
+
+        std::thread worker([&vector, first, pivot, fork_depth, grain, comp]() {
+            quicksort_parallel(vector, first, pivot, fork_depth - 1, grain, comp);
+        });
+        quicksort_parallel(vector, pivot + 1, last, fork_depth - 1, grain, comp);
+        worker.join();
+        return;
+    }
+    introsort_loop(vector, first, last, 2 * floor_log2(last - first + 1), comp);
+}
+
+//quick sort forking subranges onto at most `threads` threads,
+//subranges of at most `grain` elements are sorted with quick_sort_intro
+template<typename RandomIt, typename Compare>
+void quick_sort_parallel(RandomIt first, RandomIt last, Compare comp, std::size_t grain, std::size_t threads) {
+    auto vector = make_sort_range(first, last);
+    if (vector.size() == 0 || vector.size() == 1) return;
+
+    quicksort_parallel(vector, 0, vector.size(), fork_depth_for(threads), std::max<std::size_t>(grain, 1), comp);
+}
+
+template<typename RandomIt, typename Compare = iterator_less<RandomIt>>
+void quick_sort_parallel(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    quick_sort_parallel(first, last, comp, PARALLEL_GRAIN_SIZE, default_thread_count());
+}
+
+template<typename T, typename Compare>
+void quick_sort_parallel(std::vector<T> &vector, Compare comp, std::size_t grain, std::size_t threads) {
+    quick_sort_parallel(vector.begin(), vector.end(), comp, grain, threads);
+}
+
+template<typename T, typename Compare>
+void quick_sort_parallel(std::vector<T> &vector, Compare comp = std::less<T>()) {
+    quick_sort_parallel(vector.begin(), vector.end(), comp, PARALLEL_GRAIN_SIZE, default_thread_count());
+}
+
+//parallel merge sort helper function
+//stable merge of the sorted ranges [a_first, a_last) and [b_first, b_last) of src into out at out_first
+//the longer range is split at its middle and the split point is binary searched in the other one,
+//giving two independent merges that run on separate threads while fork_depth lasts
+template<typename Src, typename Out, typename Compare>
+void merge_parallel(Src &src, std::size_t a_first, std::size_t a_last, std::size_t b_first, std::size_t b_last,
+                    Out &out, std::size_t out_first, std::size_t fork_depth, std::size_t grain, Compare comp = std::less<range_value_t<Src>>()) {
+    count_recursion(comp);
+    std::size_t a_len = a_last - a_first;
+    std::size_t b_len = b_last - b_first;
+
+    if (fork_depth == 0 || a_len + b_len <= grain || a_len == 0 || b_len == 0) {
+        std::size_t i = a_first, j = b_first, k = out_first;
+        while (i < a_last && j < b_last) {
+            if (comp(src[j], src[i])) out[k ++] = std::move(src[j ++]);
+            else out[k ++] = std::move(src[i ++]);
+        }
+        while (i < a_last) out[k ++] = std::move(src[i ++]);
+        while (j < b_last) out[k ++] = std::move(src[j ++]);
+        return;
+    }
+
+    std::size_t a_mid, b_mid;
+    if (a_len >= b_len) {
+        //b elements equal to src[a_mid] go to the right half, after it
+        a_mid = a_first + a_len / 2;
+        b_mid = std::lower_bound(src.begin() + b_first, src.begin() + b_last, src[a_mid], comp) - src.begin();
+    }
+    else {
+        //a elements equal to src[b_mid] go to the left half, before it
+        b_mid = b_first + b_len / 2;
+        a_mid = std::upper_bound(src.begin() + a_first, src.begin() + a_last, src[b_mid], comp) - src.begin();
+    }
+    std::size_t out_mid = out_first + (a_mid - a_first) + (b_mid - b_first);
+
+    std::thread worker([&src, &out, a_first, a_mid, b_first, b_mid, out_first, fork_depth, grain, comp]() {
+        merge_parallel(src, a_first, a_mid, b_first, b_mid, out, out_first, fork_depth - 1, grain, comp);
+    });
+    merge_parallel(src, a_mid, a_last, b_mid, b_last, out, out_mid, fork_depth - 1, grain, comp);
+    worker.join();
+}
+
+//parallel merge sort helper function
+//move [first, last) of src into the same positions of out, split across threads
+template<typename Src, typename Out>
+void move_parallel(Src &src, Out &out, std::size_t first, std::size_t last, std::size_t fork_depth, std::size_t grain) {
+    if (fork_depth == 0 || last - first <= grain) {
+        std::move(src.begin() + first, src.begin() + last, out.begin() + first);
+        return;
+    }
+
+    std::size_t mid = first + (last - first) / 2;
+    std::thread worker([&src, &out, first, mid, fork_depth, grain]() {
+        move_parallel(src, out, first, mid, fork_depth - 1, grain);
+    });
+    move_parallel(src, out, mid, last, fork_depth - 1, grain);
+    worker.join();
+}
+
+//parallel merge sort helper function
+//sort both halves of [first, last) concurrently, then merge them in parallel through buffer
+//buffer is shared by all tasks, each using its own [first, last), and leaves sort with the front half of their slice
+template<typename Range, typename Compare>
+void mergesort_parallel(Range &vector, std::size_t first, std::size_t last, std::vector<range_value_t<Range>> &buffer,
+                        std::size_t fork_depth, std::size_t grain, Compare comp = std::less<range_value_t<Range>>()) {
+    count_recursion(comp);
+    if (fork_depth == 0 || last - first <= grain) {
+        auto slice = make_sort_range(buffer.begin() + (std::ptrdiff_t)first, buffer.begin() + (std::ptrdiff_t)(first + (last - first) / 2));
+        mergesort_buffered(vector, first, last, slice, comp);
+        return;
+    }
+
+    std::size_t mid = first + (last - first) / 2;
+    std::thread worker([&vector, &buffer, first, mid, fork_depth, grain, comp]() {
+        mergesort_parallel(vector, first, mid, buffer, fork_depth - 1, grain, comp);
+    });
+    mergesort_parallel(vector, mid, last, buffer, fork_depth - 1, grain, comp);
+    worker.join();
+
+    if (!comp(vector[mid], vector[mid - 1])) return; //the two halves are already in order
+
+    //both halves are done, so the merge may use every thread available at this level
+    merge_parallel(vector, first, mid, mid, last, buffer, first, fork_depth, grain, comp);
+    move_parallel(buffer, vector, first, last, fork_depth, grain);
+}
+
+//stable merge sort forking subranges onto at most `threads` threads,
+//subranges of at most `grain` elements are sorted with the bottom-up buffered merge sort
+template<typename RandomIt, typename Compare>
+void merge_sort_parallel(RandomIt first, RandomIt last, Compare comp, std::size_t grain, std::size_t threads) {
+    auto vector = make_sort_range(first, last);
+    using T = range_value_t<decltype(vector)>;
+    if (vector.size() == 0 || vector.size() == 1) return;
+
+    std::size_t fork_depth = fork_depth_for(threads);
+    grain = std::max<std::size_t>(grain, 1);
+    //a single leaf only needs half of the vector, merges at every other level need all of it
+    std::vector<T> buffer(fork_depth == 0 || vector.size() <= grain ? vector.size() / 2 : vector.size());
+    count_allocation(comp, buffer.size());
+    mergesort_parallel(vector, 0, vector.size(), buffer, fork_depth, grain, comp);
+}
+
+template<typename RandomIt, typename Compare = iterator_less<RandomIt>>
+void merge_sort_parallel(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    merge_sort_parallel(first, last, comp, PARALLEL_GRAIN_SIZE, default_thread_count());
+}
+
+template<typename T, typename Compare>
+void merge_sort_parallel(std::vector<T> &vector, Compare comp, std::size_t grain, std::size_t threads) {
+    merge_sort_parallel(vector.begin(), vector.end(), comp, grain, threads);
+}
+
+template<typename T, typename Compare>
+void merge_sort_parallel(std::vector<T> &vector, Compare comp = std::less<T>()) {
+    merge_sort_parallel(vector.begin(), vector.end(), comp, PARALLEL_GRAIN_SIZE, default_thread_count());
+}
+
+//parallel sample sort
+//largest number of buckets, bucket indices are stored in one byte
+constexpr std::size_t SAMPLE_SORT_MAX_BUCKETS = 256;
+//samples drawn per bucket, the splitters are every SAMPLE_SORT_OVERSAMPLING-th sorted sample
+constexpr std::size_t SAMPLE_SORT_OVERSAMPLING = 32;
+//elements classified together, their splitter tree descents are interleaved
+constexpr std::size_t SAMPLE_SORT_UNROLL = 8;
+
+//parallel sort helper function
+//run task(t) for every t in [0, threads), task(0) on the calling thread
+template<typename Task>
+void run_on_threads(std::size_t threads, Task task) {
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (std::size_t t = 1; t < threads; t ++) workers.emplace_back(task, t);
+    task(0);
+    for (auto &worker:workers) worker.join();
+}
+
+//sample sort helper function
+//bucket of every element of [first, last) in the splitter tree, written to bucket_of,
+//and the number of elements in each bucket, added to count
+//tree[1, buckets) holds the splitters in breadth first order: the children of tree[j] are
+//tree[2j] and tree[2j + 1], and an element goes right when the splitter is less than it,
+//so a descent is log2(buckets) comparisons whose results index the next node without branching
+template<typename Range, typename Compare>
+void classify_range(const Range &vector, std::size_t first, std::size_t last, const std::vector<range_value_t<Range>> &tree,
+                    std::size_t buckets, std::uint8_t *bucket_of, std::size_t *count, Compare comp) {
+    std::size_t levels = floor_log2(buckets);
+    std::size_t i = first;
+    for (; i + SAMPLE_SORT_UNROLL <= last; i += SAMPLE_SORT_UNROLL) {
+        std::size_t node[SAMPLE_SORT_UNROLL];
+        for (std::size_t u = 0; u < SAMPLE_SORT_UNROLL; u ++) node[u] = 1;
+        for (std::size_t level = 0; level < levels; level ++) {
+            for (std::size_t u = 0; u < SAMPLE_SORT_UNROLL; u ++) {
+                node[u] = 2 * node[u] + (std::size_t)comp(tree[node[u]], vector[i + u]);
+            }
+        }
+        for (std::size_t u = 0; u < SAMPLE_SORT_UNROLL; u ++) {
+            bucket_of[i + u] = (std::uint8_t)(node[u] - buckets);
+            count[node[u] - buckets] ++;
+        }
+    }
+    for (; i < last; i ++) {
+        std::size_t node = 1;
+        for (std::size_t level = 0; level < levels; level ++) node = 2 * node + (std::size_t)comp(tree[node], vector[i]);
+        bucket_of[i] = (std::uint8_t)(node - buckets);
+        count[node - buckets] ++;
+    }
+}
+
+//sample sort helper function
+//splitter tree for `buckets` buckets from an oversampled, sorted random sample of vector
+//tree[0] is unused, see classify_range for the layout
+template<typename Range, typename Compare>
+std::vector<range_value_t<Range>> build_splitter_tree(const Range &vector, std::size_t buckets, Compare comp) {
+    using T = range_value_t<Range>;
+    std::size_t n = vector.size();
+
+    std::vector<T> sample;
+    sample.reserve(buckets * SAMPLE_SORT_OVERSAMPLING);
+    count_allocation(comp, buckets * SAMPLE_SORT_OVERSAMPLING);
+    std::uint64_t state = 0x9e3779b97f4a7c15ull ^ n; //xorshift64, fixed seed for repeatable runs
+    for (std::size_t i = 0; i < buckets * SAMPLE_SORT_OVERSAMPLING; i ++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        sample.push_back(vector[(std::size_t)(state % n)]);
+    }
+    introsort_loop(sample, 0, sample.size(), 2 * floor_log2(sample.size()), comp);
+
+    //node j at depth d and position p within its level splits at sorted splitter (2p + 1) * buckets / 2^(d + 1)
+    std::vector<T> tree(buckets);
+    for (std::size_t j = 1; j < buckets; j ++) {
+        std::size_t depth = floor_log2(j);
+        std::size_t pos = j - (std::size_t(1) << depth);
+        std::size_t splitter = (2 * pos + 1) * (buckets >> (depth + 1));
+        tree[j] = sample[splitter * SAMPLE_SORT_OVERSAMPLING];
+    }
+    return tree;
+}
+
+//sample sort on `threads` threads, for inputs so large that the sequential top level partition
+//of quick_sort_parallel limits scaling:
+//the elements are classified into up to 256 buckets by a splitter tree built from an oversampled
+//random sample, every thread counts its own stripe, the per thread counts are prefix summed into
+//disjoint write offsets so the scatter into a buffer needs no synchronisation, and the buckets
+//are then introsorted concurrently and moved back
+//uses n extra elements and n bytes; ranges of at most `grain` elements per thread are introsorted
+template<typename RandomIt, typename Compare>
+void sample_sort(RandomIt first, RandomIt last, Compare comp, std::size_t grain, std::size_t threads) {
+    auto vector = make_sort_range(first, last);
+    using T = range_value_t<decltype(vector)>;
+    std::size_t n = vector.size();
+    threads = std::max<std::size_t>(threads, 1);
+    grain = std::max<std::size_t>(grain, 1);
+    if (threads == 1 || n <= grain * 2) {
+        if (n > 1) introsort_loop(vector, 0, n, 2 * floor_log2(n), comp);
+        return;
+    }
+
+    //several buckets per thread even out their sizes, and each bucket should still hold about grain elements
+    std::size_t buckets = 2;
+    while (buckets < SAMPLE_SORT_MAX_BUCKETS && buckets < 4 * threads && buckets * 2 * grain <= n) buckets *= 2;
+    threads = std::min(threads, n / grain);
+    std::vector<T> tree = build_splitter_tree(vector, buckets, comp);
+
+    //classification, each thread counts its own stripe
+    std::vector<std::uint8_t> bucket_of(n);
+    std::vector<std::size_t> offsets(threads * buckets, 0);
+    count_allocation(comp, n);
+    run_on_threads(threads, [&, comp](std::size_t t) {
+        classify_range(vector, n * t / threads, n * (t + 1) / threads, tree, buckets, bucket_of.data(), &offsets[t * buckets], comp);
+    });
+
+    //bucket b of thread t is written from offsets[t * buckets + b]: buckets in order, threads in order within a bucket
+    std::vector<std::size_t> bucket_first(buckets + 1);
+    std::size_t offset = 0;
+    for (std::size_t b = 0; b < buckets; b ++) {
+        bucket_first[b] = offset;
+        for (std::size_t t = 0; t < threads; t ++) {
+            std::size_t count = offsets[t * buckets + b];
+            offsets[t * buckets + b] = offset;
+            offset += count;
+        }
+    }
+    bucket_first[buckets] = n;
+
+    std::vector<T> buffer(n);
+    count_allocation(comp, n);
+    run_on_threads(threads, [&](std::size_t t) {
+        std::size_t *bucket_offset = &offsets[t * buckets];
+        for (std::size_t i = n * t / threads; i < n * (t + 1) / threads; i ++) {
+            buffer[bucket_offset[bucket_of[i]] ++] = std::move(vector[i]);
+        }
+    });
+
+    //buckets are handed out largest first, so a big bucket does not start last
+    std::vector<std::size_t> order(buckets);
+    for (std::size_t b = 0; b < buckets; b ++) order[b] = b;
+    std::sort(order.begin(), order.end(), [&bucket_first](std::size_t a, std::size_t b) {
+        return bucket_first[a + 1] - bucket_first[a] > bucket_first[b + 1] - bucket_first[b];
+    });
+    std::atomic<std::size_t> next(0);
+    run_on_threads(threads, [&, comp](std::size_t) {
+        for (std::size_t i = next ++; i < buckets; i = next ++) {
+            std::size_t lo = bucket_first[order[i]], hi = bucket_first[order[i] + 1];
+            if (hi - lo > 1) introsort_loop(buffer, lo, hi, 2 * floor_log2(hi - lo), comp);
+            std::move(buffer.begin() + (std::ptrdiff_t)lo, buffer.begin() + (std::ptrdiff_t)hi, vector.begin() + (std::ptrdiff_t)lo);
+        }
+    });
+}
+
+template<typename RandomIt, typename Compare = iterator_less<RandomIt>>
+void sample_sort(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    sample_sort(first, last, comp, PARALLEL_GRAIN_SIZE, default_thread_count());
+}
+
+template<typename T, typename Compare>
+void sample_sort(std::vector<T> &vector, Compare comp, std::size_t grain, std::size_t threads) {
+    sample_sort(vector.begin(), vector.end(), comp, grain, threads);
+}
+
+template<typename T, typename Compare>
+void sample_sort(std::vector<T> &vector, Compare comp = std::less<T>()) {
+    sample_sort(vector.begin(), vector.end(), comp, PARALLEL_GRAIN_SIZE, default_thread_count());
+}
+
+
+//radix sort
+//vectors shorter than this go to quick_sort_intro, the histograms are not worth it
+constexpr std::size_t RADIX_SORT_THRESHOLD = 64;
+
+//radix sort helper
+//unsigned key type wide enough to hold the bits of T
+template<typename T>
+using radix_key_t = typename std::conditional<sizeof(T) <= 4, std::uint32_t, std::uint64_t>::type;
+
+//radix sort helper
+//map el to an unsigned key whose unsigned order is the order of el:
+//signed integers get their sign bit flipped, negative floating point numbers get all bits flipped
+//and non negative ones only the sign bit
+template<typename T>
+radix_key_t<T> radix_key(T el) {
+    using Key = radix_key_t<T>;
+    constexpr unsigned int bits = sizeof(T) * 8;
+
+    if constexpr (std::is_floating_point<T>::value) {
+        Key key;
+        std::memcpy(&key, &el, sizeof(T));
+        constexpr Key sign = Key(1) << (bits - 1);
+        return (key & sign) ? ~key : (key | sign);
+    }
+    else if constexpr (std::is_signed<T>::value) {
+        Key key = static_cast<Key>(static_cast<typename std::make_unsigned<T>::type>(el));
+        return key ^ (Key(1) << (bits - 1));
+    }
+    else {
+        return static_cast<Key>(el);
+    }
+}
+
+//radix sort helper function
+//stable ascending LSD radix sort of vector by the unsigned keys key_of(el), one byte per pass
+//all byte histograms are built in a single pass over the input, and a pass is skipped
+//when every element has the same value in that byte
+template<typename Range, typename KeyOf>
+void lsd_radix_sort(Range &vector, KeyOf key_of) {
+    using T = range_value_t<Range>;
+    using Key = decltype(key_of(vector[0]));
+    constexpr std::size_t passes = sizeof(Key);
+    std::size_t n = vector.size();
+    if (n == 0) return;
+
+    std::vector<std::size_t> counts(passes * 256, 0);
+    for (const T &el:vector) {
+        Key key = key_of(el);
+        for (std::size_t p = 0; p < passes; p ++) {
+            counts[p * 256 + ((key >> (8 * p)) & 0xff)] ++;
+        }
+    }
+
+    //stable scatter of src into dst by byte p, count holds the first destination of every byte value
+    auto scatter = [n, key_of](auto src, auto dst, std::size_t p, std::size_t *count) {
+        for (std::size_t i = 0; i < n; i ++) {
+            auto &el = src[(std::ptrdiff_t)i];
+            dst[(std::ptrdiff_t)count[(key_of(el) >> (8 * p)) & 0xff] ++] = std::move(el);
+        }
+    };
+
+    std::vector<T> buffer(n);
+    bool in_buffer = false; //whether the elements currently live in buffer
+    for (std::size_t p = 0; p < passes; p ++) {
+        std::size_t *count = &counts[p * 256];
+        const T &front = in_buffer ? buffer[0] : vector[0];
+        if (count[(key_of(front) >> (8 * p)) & 0xff] == n) continue; //trivial digit
+
+        std::size_t offset = 0;
+        for (std::size_t b = 0; b < 256; b ++) {
+            std::size_t c = count[b];
+            count[b] = offset;
+            offset += c;
+        }
+        if (in_buffer) scatter(buffer.begin(), vector.begin(), p, count);
+        else scatter(vector.begin(), buffer.begin(), p, count);
+        in_buffer = !in_buffer;
+    }
+
+    if (in_buffer) std::move(buffer.begin(), buffer.end(), vector.begin());
+}
+
+//radix sort helper function
+//ascending LSD radix sort of arithmetic elements by their own value
+template<typename Range>
+void lsd_radix_sort(Range &vector) {
+    lsd_radix_sort(vector, [](const range_value_t<Range> &el) { return radix_key(el); });
+}
+
+//radix sort for integral and floating point vectors
+//comp must be std::less or std::greater, the order comes from the key bits
+template<typename RandomIt, typename Compare = iterator_less<RandomIt>>
+void radix_sort(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    auto vector = make_sort_range(first, last);
+    using T = range_value_t<decltype(vector)>;
+    static_assert(is_radix_sortable<T>::value, "radix_sort needs an integral or IEEE 754 float / double element type");
+    static_assert(is_natural_less<T, Compare>::value || is_natural_greater<T, Compare>::value,
+                  "radix_sort only sorts by std::less or std::greater");
+
+    if (vector.size() < RADIX_SORT_THRESHOLD) {
+        quick_sort_intro(vector.begin(), vector.end(), comp);
+        return;
+    }
+
+    count_allocation(comp, vector.size()); //the scatter buffer of lsd_radix_sort
+    lsd_radix_sort(vector);
+    if (is_natural_greater<T, Compare>::value) std::reverse(vector.begin(), vector.end());
+}
+
+template<typename T, typename Compare>
+void radix_sort(std::vector<T> &vector, Compare comp = std::less<T>()) {
+    radix_sort(vector.begin(), vector.end(), comp);
+}
+
+//string sort
+//ranges of at most this many strings are finished with insertion sort
+constexpr std::size_t STRING_SORT_INSERTION_THRESHOLD = 16;
+
+//string sort helper
+//std::string and std::string_view, the element types of string_sort
+template<typename T>
+struct is_string_sortable : std::integral_constant<bool,
+    std::is_same<T, std::string>::value || std::is_same<T, std::string_view>::value> {};
+
+//string sort helper
+//the characters [depth, depth + 8) of a string as a big endian word, zero padded past the end,
+//and the number of them that exist: ordering keys by (word, length) orders the strings by those characters,
+//and equal keys of length 8 need the next 8 characters to be told apart
+struct string_key {
+    std::uint64_t word;
+    std::size_t length;
+};
+
+inline bool operator<(const string_key &a, const string_key &b) {
+    return a.word < b.word || (a.word == b.word && a.length < b.length);
+}
+
+//string sort helper function
+//the string_key of s at depth
+template<typename String>
+inline string_key key_at(const String &s, std::size_t depth) {
+    std::size_t length = depth < s.size() ? std::min<std::size_t>(s.size() - depth, 8) : 0;
+    const char *chars = s.data() + depth;
+    std::uint64_t word = 0;
+    if (length == 8) {
+        for (std::size_t k = 0; k < 8; k ++) word = word << 8 | (unsigned char)chars[k]; //compiles to a byte swapped load
+    }
+    else {
+        for (std::size_t k = 0; k < length; k ++) word |= (std::uint64_t)(unsigned char)chars[k] << (56 - 8 * k);
+    }
+    return string_key{word, length};
+}
+
+//string sort helper function
+//length of the longest common prefix of a and b, which are known to share their first depth characters
+template<typename String>
+std::size_t common_prefix(const String &a, const String &b, std::size_t depth) {
+    std::size_t n = std::min(a.size(), b.size());
+    while (depth < n && a[depth] == b[depth]) depth ++;
+    return depth;
+}
+
+//string sort helper struct
+//entry of the multikey quicksort: the cached key of a string at the current depth and its index
+struct string_entry {
+    string_key key;
+    std::size_t index;
+};
+
+//string sort helper function
+//comparator of entries whose strings share their first depth characters and carry their keys at depth:
+//the cached keys decide first, ties of full keys are broken by the characters from depth + 8 on
+template<typename Range>
+auto string_entry_less(const Range &vector, std::size_t depth) {
+    return [&vector, depth](const string_entry &a, const string_entry &b) {
+        if (a.key < b.key) return true;
+        if (b.key < a.key || a.key.length < 8) return false;
+        const auto &x = vector[a.index];
+        const auto &y = vector[b.index];
+        std::size_t p = common_prefix(x, y, depth + 8);
+        return p < y.size() && (p == x.size() || (unsigned char)x[p] < (unsigned char)y[p]);
+    };
+}
+
+//string sort helper function
+//caching multikey quicksort of order[first, last), whose strings share their first depth characters:
+//a three way partition on the cached keys of the next 8 characters, then the < and > parts are sorted
+//at the same depth and the == part 8 characters deeper, after reloading its keys; so the partitions only
+//read the compact entries, the strings are read once per 8 characters, and a shared prefix is never
+//compared again; the two smaller parts are recursed into and the largest one looped on
+//once depth_limit unbalanced partitions were made, the rest is heap sorted as in introsort
+//lcp[i] for i in (first, last) receives a lower bound of the common prefix of the sorted strings i - 1 and i:
+//depth across a partition boundary or inside an insertion sorted range, the length for equal strings
+template<typename Range>
+void multikey_quicksort(const Range &vector, std::vector<string_entry> &order, std::size_t first, std::size_t last, std::size_t depth,
+                        std::size_t depth_limit, std::size_t *lcp) {
+    while (last - first > STRING_SORT_INSERTION_THRESHOLD) {
+        if (depth_limit == 0) {
+            heap_sort_range(order, first, last, string_entry_less(vector, depth));
+            if (lcp) for (std::size_t k = first + 1; k < last; k ++) lcp[k] = depth;
+            return;
+        }
+
+        //median of three or ninther keys, as in introsort: a partition leaves sorted input rotated,
+        //which defeats a plain median of three
+        auto key_less = [](const string_entry &a, const string_entry &b) { return a.key < b.key; };
+        string_key pivot = order[choose_pivot(order, first, last, key_less)].key;
+
+        //dutch national flag: [first, lt) < pivot, [lt, i) == pivot, [gt, last) > pivot
+        std::size_t lt = first, i = first, gt = last;
+        while (i < gt) {
+            if (order[i].key < pivot) std::swap(order[lt ++], order[i ++]);
+            else if (pivot < order[i].key) std::swap(order[i], order[-- gt]);
+            else i ++;
+        }
+
+        if (lcp) {
+            if (lt > first) lcp[lt] = depth;
+            if (gt < last) lcp[gt] = depth;
+        }
+
+        //when the pivot reaches the end of its strings, the == part holds equal strings
+        std::size_t eq_first = lt, eq_last = gt;
+        if (pivot.length < 8) {
+            if (lcp) for (std::size_t k = lt + 1; k < gt; k ++) lcp[k] = depth + pivot.length;
+            eq_first = eq_last = lt;
+        }
+        else {
+            for (std::size_t k = lt; k < gt; k ++) order[k].key = key_at(vector[order[k].index], depth + 8);
+        }
+
+        //parts as (first, last, depth, depth_limit), the largest is looped on
+        //only the < and > parts use up the depth limit, the == part made progress by consuming 8 characters
+        std::size_t parts[3][4] = {{first, lt, depth, depth_limit - 1}, {eq_first, eq_last, depth + 8, depth_limit}, {gt, last, depth, depth_limit - 1}};
+        std::size_t largest = 0;
+        for (std::size_t k = 1; k < 3; k ++) {
+            if (parts[k][1] - parts[k][0] > parts[largest][1] - parts[largest][0]) largest = k;
+        }
+        for (std::size_t k = 0; k < 3; k ++) {
+            if (k != largest && parts[k][1] - parts[k][0] > 1) {
+                multikey_quicksort(vector, order, parts[k][0], parts[k][1], parts[k][2], parts[k][3], lcp);
+            }
+        }
+        first = parts[largest][0];
+        last = parts[largest][1];
+        depth = parts[largest][2];
+        depth_limit = parts[largest][3];
+    }
+    if (last - first > 1) {
+        insertion_sort_range(order, first, last, string_entry_less(vector, depth));
+        if (lcp) for (std::size_t k = first + 1; k < last; k ++) lcp[k] = depth;
+    }
+}
+
+//lexicographic sort of strings (std::string or std::string_view) by multikey quicksort, for keys with long
+//common prefixes such as URLs and paths: unlike a comparison sort, shared prefixes are not compared again
+//the order is that of std::less<std::string>, chars compared as unsigned; not stable
+//uses an entry of a key and an index per string, and moves the strings once through a scratch vector
+//if lcp is given it must hold last - first elements: lcp[0] = 0, and lcp[i] is the length of the longest
+//common prefix of the sorted elements i - 1 and i, so duplicates are the i with lcp[i] == size of element i
+template<typename RandomIt>
+void string_sort(RandomIt first, RandomIt last, std::size_t *lcp = nullptr) {
+    auto vector = make_sort_range(first, last);
+    static_assert(is_string_sortable<range_value_t<decltype(vector)>>::value, "string_sort needs std::string or std::string_view elements");
+    std::size_t n = vector.size();
+    if (lcp && n > 0) lcp[0] = 0;
+    if (n < 2) return;
+
+    std::vector<string_entry> order(n);
+    for (std::size_t i = 0; i < n; i ++) order[i] = string_entry{key_at(vector[i], 0), i};
+    multikey_quicksort(vector, order, 0, n, 0, 2 * floor_log2(n), lcp);
+
+    //gather the strings in order, sequential writes beat following the cycles of the permutation in place
+    using T = range_value_t<decltype(vector)>;
+    std::vector<T> sorted;
+    sorted.reserve(n);
+    for (const string_entry &entry:order) sorted.push_back(std::move(vector[entry.index]));
+    std::move(sorted.begin(), sorted.end(), vector.begin());
+
+    if (lcp) {
+        //extend the lower bounds, across a partition boundary the strings differ within 8 characters
+        for (std::size_t i = 1; i < n; i ++) lcp[i] = common_prefix(vector[i - 1], vector[i], lcp[i]);
+    }
+}
+
+template<typename T>
+void string_sort(std::vector<T> &vector, std::size_t *lcp = nullptr) {
+    string_sort(vector.begin(), vector.end(), lcp);
+}
+
+//string sort that also returns the lcp array, resized to the number of strings
+template<typename T>
+void string_sort(std::vector<T> &vector, std::vector<std::size_t> &lcp) {
+    lcp.resize(vector.size());
+    string_sort(vector.begin(), vector.end(), lcp.data());
+}
+
+//sort vector by comp, picking the algorithm from the element and comparator types:
+//radix sort for arithmetic elements under std::less / std::greater, multikey quicksort for strings
+//under std::less, introsort otherwise
+template<typename T, typename Compare = std::less<T>>
+void sort(std::vector<T> &vector, Compare comp = Compare()) {
+    if constexpr (is_radix_sortable<T>::value && (is_natural_less<T, Compare>::value || is_natural_greater<T, Compare>::value)) {
+        radix_sort(vector, comp);
+    }
+    else if constexpr (is_string_sortable<T>::value && is_natural_less<T, Compare>::value) {
+        string_sort(vector);
+    }
+    else {
+        quick_sort_intro(vector, comp);
+    }
+}
+
+//sort a fixed size array: arrays of at most SORT_NETWORK_MAX elements go through static_sort,
+//larger ones are sorted like a vector
+template<typename T, std::size_t N, typename Compare = std::less<T>>
+void sort(std::array<T, N> &arr, Compare comp = Compare()) {
+    if constexpr (N <= SORT_NETWORK_MAX) {
+        static_sort(arr, comp);
+    }
+    else if constexpr (is_radix_sortable<T>::value && (is_natural_less<T, Compare>::value || is_natural_greater<T, Compare>::value)) {
+        radix_sort(arr.begin(), arr.end(), comp);
+    }
+    else if constexpr (is_string_sortable<T>::value && is_natural_less<T, Compare>::value) {
+        string_sort(arr.begin(), arr.end());
+    }
+    else {
+        quick_sort_intro(arr.begin(), arr.end(), comp);
+    }
+}
+
+
+//adaptive merge sort
+//vectors shorter than this are sorted with a single binary insertion sort
+constexpr std::size_t ADAPTIVE_MIN_MERGE = 32;
+//number of consecutive wins by one run before a merge switches to galloping
+constexpr std::ptrdiff_t ADAPTIVE_MIN_GALLOP = 7;
+
+//adaptive merge sort helper function
+//minimum run length for n elements: a value in [16, 32] such that n / min_run is
+//a power of two or slightly below one, which keeps the final merges balanced
+inline std::size_t adaptive_min_run(std::size_t n) {
+    std::size_t r = 0;
+    while (n >= ADAPTIVE_MIN_MERGE) {
+        r |= (n & 1);
+        n >>= 1;
+    }
+    return n + r;
+}
+
+//adaptive merge sort helper function
+//length of the run starting at lo, a strictly descending run is reversed in place
+//descending runs must be strict so that reversing them keeps the sort stable
+template<typename Range, typename Compare>
+std::size_t count_run(Range &vector, std::size_t lo, std::size_t hi, Compare comp = std::less<range_value_t<Range>>()) {
+    std::size_t run_hi = lo + 1;
+    if (run_hi == hi) return 1;
+
+    if (comp(vector[run_hi], vector[lo])) {
+        run_hi ++;
+        while (run_hi < hi && comp(vector[run_hi], vector[run_hi - 1])) run_hi ++;
+        std::reverse(vector.begin() + (std::ptrdiff_t)lo, vector.begin() + (std::ptrdiff_t)run_hi);
+    }
+    else {
+        run_hi ++;
+        while (run_hi < hi && !comp(vector[run_hi], vector[run_hi - 1])) run_hi ++;
+    }
+    return run_hi - lo;
+}
+
+//adaptive merge sort helper function
+//stable binary insertion sort of [lo, hi) where [lo, start) is already sorted
+template<typename Range, typename Compare>
+void binary_insertion_sort(Range &vector, std::size_t lo, std::size_t hi, std::size_t start, Compare comp = std::less<range_value_t<Range>>()) {
+    using T = range_value_t<Range>;
+    for (std::size_t i = start; i < hi; i ++) {
+        T el = std::move(vector[i]);
+
+        //find the first position whose element is greater than el, so equal keys keep their order
+        std::size_t left = lo, right = i;
+        while (left < right) {
+            std::size_t mid = left + (right - left) / 2;
+            if (comp(el, vector[mid])) right = mid;
+            else left = mid + 1;
+        }
+
+        std::move_backward(vector.begin() + (std::ptrdiff_t)left, vector.begin() + (std::ptrdiff_t)i, vector.begin() + (std::ptrdiff_t)(i + 1));
+        vector[left] = std::move(el);
+    }
+}
+
+//adaptive merge sort helper function
+//position of key in the sorted range arr[base, base + len), searching outwards from hint:
+//return k such that arr[base + k - 1] < key <= arr[base + k] (leftmost position)
+template<typename T, typename Range, typename Compare>
+std::ptrdiff_t gallop_left(const T &key, const Range &arr, std::ptrdiff_t base, std::ptrdiff_t len, std::ptrdiff_t hint, Compare comp) {
+    std::ptrdiff_t last_ofs = 0, ofs = 1;
+    if (comp(arr[base + hint], key)) {
+        //gallop right until arr[base + hint + last_ofs] < key <= arr[base + hint + ofs]
+        std::ptrdiff_t max_ofs = len - hint;
+        while (ofs < max_ofs && comp(arr[base + hint + ofs], key)) {
+            last_ofs = ofs;
+            ofs = 2 * ofs + 1;
+        }
+        if (ofs > max_ofs) ofs = max_ofs;
+        last_ofs += hint;
+        ofs += hint;
+    }
+    else {
+        //gallop left until arr[base + hint - ofs] < key <= arr[base + hint - last_ofs]
+        std::ptrdiff_t max_ofs = hint + 1;
+        while (ofs < max_ofs && !comp(arr[base + hint - ofs], key)) {
+            last_ofs = ofs;
+            ofs = 2 * ofs + 1;
+        }
+        if (ofs > max_ofs) ofs = max_ofs;
+        std::ptrdiff_t tmp = last_ofs;
+        last_ofs = hint - ofs;
+        ofs = hint - tmp;
+    }
+
+    //binary search in (last_ofs, ofs]
+    last_ofs ++;
+    while (last_ofs < ofs) {
+        std::ptrdiff_t mid = last_ofs + (ofs - last_ofs) / 2;
+        if (comp(arr[base + mid], key)) last_ofs = mid + 1;
+        else ofs = mid;
+    }
+    return ofs;
+}
+
+//adaptive merge sort helper function
+//like gallop_left, but return k such that arr[base + k - 1] <= key < arr[base + k] (rightmost position)
+template<typename T, typename Range, typename Compare>
+std::ptrdiff_t gallop_right(const T &key, const Range &arr, std::ptrdiff_t base, std::ptrdiff_t len, std::ptrdiff_t hint, Compare comp) {
+    std::ptrdiff_t last_ofs = 0, ofs = 1;
+    if (comp(key, arr[base + hint])) {
+        //gallop left until arr[base + hint - ofs] <= key < arr[base + hint - last_ofs]
+        std::ptrdiff_t max_ofs = hint + 1;
+        while (ofs < max_ofs && comp(key, arr[base + hint - ofs])) {
+            last_ofs = ofs;
+            ofs = 2 * ofs + 1;
+        }
+        if (ofs > max_ofs) ofs = max_ofs;
+        std::ptrdiff_t tmp = last_ofs;
+        last_ofs = hint - ofs;
+        ofs = hint - tmp;
+    }
+    else {
+        //gallop right until arr[base + hint + last_ofs] <= key < arr[base + hint + ofs]
+        std::ptrdiff_t max_ofs = len - hint;
+        while (ofs < max_ofs && !comp(key, arr[base + hint + ofs])) {
+            last_ofs = ofs;
+            ofs = 2 * ofs + 1;
+        }
+        if (ofs > max_ofs) ofs = max_ofs;
+        last_ofs += hint;
+        ofs += hint;
+    }
+
+    //binary search in (last_ofs, ofs]
+    last_ofs ++;
+    while (last_ofs < ofs) {
+        std::ptrdiff_t mid = last_ofs + (ofs - last_ofs) / 2;
+        if (comp(key, arr[base + mid])) ofs = mid;
+        else last_ofs = mid + 1;
+    }
+    return ofs;
+}
+
+//adaptive merge sort helper class
+//keeps the stack of pending runs, the merge buffer and the galloping threshold for one sort call
+//the run stack invariants len[i - 2] > len[i - 1] + len[i] and len[i - 1] > len[i] bound its height by O(log n)
+template<typename Range, typename Compare>
+class adaptive_merge_state {
+public:
+    using T = range_value_t<Range>;
+
+    adaptive_merge_state(Range &vector, Compare compare) : arr(vector), comp(compare) {}
+
+    //push the run [base, base + len) and merge until the stack invariants hold again
+    void push_run(std::ptrdiff_t base, std::ptrdiff_t len) {
+        runs.push_back({base, len});
+        merge_collapse();
+    }
+
+    //merge every pending run, leaving the whole vector sorted
+    void merge_force_collapse() {
+        while (runs.size() > 1) {
+            std::size_t n = runs.size() - 2;
+            if (n > 0 && runs[n - 1].second < runs[n + 1].second) n --;
+            merge_at(n);
+        }
+    }
+
+private:
+    Range &arr;
+    Compare comp;
+    std::vector<T> buffer;
+    std::vector<std::pair<std::ptrdiff_t, std::ptrdiff_t>> runs; //(base, length) of each pending run
+    std::ptrdiff_t min_gallop = ADAPTIVE_MIN_GALLOP;
+
+    void merge_collapse() {
+        while (runs.size() > 1) {
+            std::size_t n = runs.size() - 2;
+            if ((n > 0 && runs[n - 1].second <= runs[n].second + runs[n + 1].second) ||
+                (n > 1 && runs[n - 2].second <= runs[n].second + runs[n - 1].second)) {
+                if (runs[n - 1].second < runs[n + 1].second) n --;
+            }
+            else if (runs[n].second > runs[n + 1].second) {
+                break; //invariants hold
+            }
+            merge_at(n);
+        }
+    }
+
+    //merge runs[i] and runs[i + 1]
+    void merge_at(std::size_t i) {
+        std::ptrdiff_t base1 = runs[i].first, len1 = runs[i].second;
+        std::ptrdiff_t base2 = runs[i + 1].first, len2 = runs[i + 1].second;
+
+        runs[i].second = len1 + len2;
+        runs.erase(runs.begin() + (std::ptrdiff_t)i + 1);
+
+        //elements of run 1 not greater than the first of run 2 are already in place
+        std::ptrdiff_t k = gallop_right(arr[base2], arr, base1, len1, 0, comp);
+        base1 += k;
+        len1 -= k;
+        if (len1 == 0) return;
+
+        //elements of run 2 not less than the last of run 1 are already in place
+        len2 = gallop_left(arr[base1 + len1 - 1], arr, base2, len2, len2 - 1, comp);
+        if (len2 == 0) return;
+
+        if (len1 <= len2) merge_lo(base1, len1, base2, len2);
+        else merge_hi(base1, len1, base2, len2);
+    }
+
+    //merge front to back with run 1 moved out into the buffer, for len1 <= len2
+    void merge_lo(std::ptrdiff_t base1, std::ptrdiff_t len1, std::ptrdiff_t base2, std::ptrdiff_t len2) {
+        if ((std::ptrdiff_t)buffer.size() < len1) {
+            count_allocation(comp, (std::size_t)len1);
+            buffer.resize((std::size_t)len1);
+        }
+        std::move(arr.begin() + base1, arr.begin() + base1 + len1, buffer.begin());
+
+        std::ptrdiff_t cursor1 = 0, cursor2 = base2, dest = base1;
+
+        //the first element of run 2 is known to go first, the last of run 1 is known to go last
+        arr[dest ++] = std::move(arr[cursor2 ++]);
+        if (-- len2 == 0) {
+            std::move(buffer.begin(), buffer.begin() + len1, arr.begin() + dest);
+            return;
+        }
+        if (len1 == 1) {
+            std::move(arr.begin() + cursor2, arr.begin() + cursor2 + len2, arr.begin() + dest);
+            arr[dest + len2] = std::move(buffer[0]);
+            return;
+        }
+
+        while (true) {
+            std::ptrdiff_t count1 = 0; //times in a row run 1 won
+            std::ptrdiff_t count2 = 0; //times in a row run 2 won
+
+            //one element at a time until a run keeps winning
+            bool done = false;
+            do {
+                if (comp(arr[cursor2], buffer[cursor1])) {
+                    arr[dest ++] = std::move(arr[cursor2 ++]);
+                    count2 ++;
+                    count1 = 0;
+                    if (-- len2 == 0) { done = true; break; }
+                }
+                else {
+                    arr[dest ++] = std::move(buffer[cursor1 ++]);
+                    count1 ++;
+                    count2 = 0;
+                    if (-- len1 == 1) { done = true; break; }
+                }
+            } while ((count1 | count2) < min_gallop);
+            if (done) break;
+
+            //gallop: move whole blocks while they stay long
+            do {
+                count1 = gallop_right(arr[cursor2], buffer, cursor1, len1, 0, comp);
+                if (count1 != 0) {
+                    std::move(buffer.begin() + cursor1, buffer.begin() + cursor1 + count1, arr.begin() + dest);
+                    dest += count1;
+                    cursor1 += count1;
+                    len1 -= count1;
+                    if (len1 <= 1) { done = true; break; }
+                }
+                arr[dest ++] = std::move(arr[cursor2 ++]);
+                if (-- len2 == 0) { done = true; break; }
+
+                count2 = gallop_left(buffer[cursor1], arr, cursor2, len2, 0, comp);
+                if (count2 != 0) {
+                    std::move(arr.begin() + cursor2, arr.begin() + cursor2 + count2, arr.begin() + dest);
+                    dest += count2;
+                    cursor2 += count2;
+                    len2 -= count2;
+                    if (len2 == 0) { done = true; break; }
+                }
+                arr[dest ++] = std::move(buffer[cursor1 ++]);
+                if (-- len1 == 1) { done = true; break; }
+                min_gallop --;
+            } while (count1 >= ADAPTIVE_MIN_GALLOP || count2 >= ADAPTIVE_MIN_GALLOP);
+            if (done) break;
+
+            if (min_gallop < 0) min_gallop = 0;
+            min_gallop += 2; //penalize leaving gallop mode
+        }
+        if (min_gallop < 1) min_gallop = 1;
+
+        if (len1 == 1) {
+            std::move(arr.begin() + cursor2, arr.begin() + cursor2 + len2, arr.begin() + dest);
+            arr[dest + len2] = std::move(buffer[cursor1]);
+        }
+        else {
+            std::move(buffer.begin() + cursor1, buffer.begin() + cursor1 + len1, arr.begin() + dest);
+        }
+    }
+
+    //merge back to front with run 2 moved out into the buffer, for len1 > len2
+    void merge_hi(std::ptrdiff_t base1, std::ptrdiff_t len1, std::ptrdiff_t base2, std::ptrdiff_t len2) {
+        if ((std::ptrdiff_t)buffer.size() < len2) {
+            count_allocation(comp, (std::size_t)len2);
+            buffer.resize((std::size_t)len2);
+        }
+        std::move(arr.begin() + base2, arr.begin() + base2 + len2, buffer.begin());
+
+        std::ptrdiff_t cursor1 = base1 + len1 - 1, cursor2 = len2 - 1, dest = base2 + len2 - 1;
+
+        //the last element of run 1 is known to go last, the first of run 2 is known to go first
+        arr[dest --] = std::move(arr[cursor1 --]);
+        if (-- len1 == 0) {
+            std::move(buffer.begin(), buffer.begin() + len2, arr.begin() + dest - (len2 - 1));
+            return;
+        }
+        if (len2 == 1) {
+            dest -= len1;
+            cursor1 -= len1;
+            std::move_backward(arr.begin() + cursor1 + 1, arr.begin() + cursor1 + 1 + len1, arr.begin() + dest + 1 + len1);
+            arr[dest] = std::move(buffer[cursor2]);
+            return;
+        }
+
+        while (true) {
+            std::ptrdiff_t count1 = 0; //times in a row run 1 won
+            std::ptrdiff_t count2 = 0; //times in a row run 2 won
+
+            //one element at a time until a run keeps winning
+            bool done = false;
+            do {
+                if (comp(buffer[cursor2], arr[cursor1])) {
+                    arr[dest --] = std::move(arr[cursor1 --]);
+                    count1 ++;
+                    count2 = 0;
+                    if (-- len1 == 0) { done = true; break; }
+                }
+                else {
+                    arr[dest --] = std::move(buffer[cursor2 --]);
+                    count2 ++;
+                    count1 = 0;
+                    if (-- len2 == 1) { done = true; break; }
+                }
+            } while ((count1 | count2) < min_gallop);
+            if (done) break;
+
+            //gallop: move whole blocks while they stay long
+            do {
+                count1 = len1 - gallop_right(buffer[cursor2], arr, base1, len1, len1 - 1, comp);
+                if (count1 != 0) {
+                    dest -= count1;
+                    cursor1 -= count1;
+                    len1 -= count1;
+                    std::move_backward(arr.begin() + cursor1 + 1, arr.begin() + cursor1 + 1 + count1, arr.begin() + dest + 1 + count1);
+                    if (len1 == 0) { done = true; break; }
+                }
+                arr[dest --] = std::move(buffer[cursor2 --]);
+                if (-- len2 == 1) { done = true; break; }
+
+                count2 = len2 - gallop_left(arr[cursor1], buffer, 0, len2, len2 - 1, comp);
+                if (count2 != 0) {
+                    dest -= count2;
+                    cursor2 -= count2;
+                    len2 -= count2;
+                    std::move(buffer.begin() + cursor2 + 1, buffer.begin() + cursor2 + 1 + count2, arr.begin() + dest + 1);
+                    if (len2 <= 1) { done = true; break; }
+                }
+                arr[dest --] = std::move(arr[cursor1 --]);
+                if (-- len1 == 0) { done = true; break; }
+                min_gallop --;
+            } while (count1 >= ADAPTIVE_MIN_GALLOP || count2 >= ADAPTIVE_MIN_GALLOP);
+            if (done) break;
+
+            if (min_gallop < 0) min_gallop = 0;
+            min_gallop += 2; //penalize leaving gallop mode
+        }
+        if (min_gallop < 1) min_gallop = 1;
+
+        if (len2 == 1) {
+            dest -= len1;
+            cursor1 -= len1;
+            std::move_backward(arr.begin() + cursor1 + 1, arr.begin() + cursor1 + 1 + len1, arr.begin() + dest + 1 + len1);
+            arr[dest] = std::move(buffer[cursor2]);
+        }
+        else {
+            std::move(buffer.begin(), buffer.begin() + len2, arr.begin() + dest - (len2 - 1));
+        }
+    }
+};
+
+//stable natural merge sort: detects ascending and strictly descending runs, extends short runs
+//to the minimum run length with binary insertion sort and merges them with galloping,
+//so concatenations of sorted chunks and nearly sorted inputs sort in close to O(n)
+template<typename RandomIt, typename Compare = iterator_less<RandomIt>>
+void merge_sort_adaptive(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    auto vector = make_sort_range(first, last);
+    std::size_t n = vector.size();
+    if (n == 0 || n == 1) return;
+
+    if (n < ADAPTIVE_MIN_MERGE) {
+        binary_insertion_sort(vector, 0, n, count_run(vector, 0, n, comp), comp);
+        return;
+    }
+
+    adaptive_merge_state<decltype(vector), Compare> state(vector, comp);
+    std::size_t min_run = adaptive_min_run(n);
+    std::size_t lo = 0;
+    while (lo < n) {
+        std::size_t run_len = count_run(vector, lo, n, comp);
+        if (run_len < min_run) {
+            std::size_t force = std::min(min_run, n - lo);
+            binary_insertion_sort(vector, lo, lo + force, lo + run_len, comp);
+            run_len = force;
+        }
+        state.push_run((std::ptrdiff_t)lo, (std::ptrdiff_t)run_len);
+        lo += run_len;
+    }
+    state.merge_force_collapse();
+}
+
+template<typename T, typename Compare>
+void merge_sort_adaptive(std::vector<T> &vector, Compare comp = std::less<T>()) {
+    merge_sort_adaptive(vector.begin(), vector.end(), comp);
+}
+
+
+//external merge sort
+//smallest read / write block used while merging, the fan-in shrinks before blocks get smaller
+constexpr std::size_t EXTERNAL_MIN_BLOCK_BYTES = 64 * 1024;
+
+//external sort helper class
+//sequential reader of a sorted run file with double buffering:
+//while the current block is consumed, the next one is read on a background thread
+template<typename T>
+class run_reader {
+public:
+    run_reader(std::FILE *run_file, std::size_t block_records) : file(run_file), current(block_records), next(block_records) {
+        std::rewind(file);
+        prefetch();
+        advance_block();
+    }
+
+    run_reader(const run_reader &) = delete;
+    run_reader &operator=(const run_reader &) = delete;
+
+    ~run_reader() {
+        if (pending.valid()) pending.wait();
+    }
+
+    bool empty() const { return pos == size; }
+
+    const T &front() const { return current[pos]; }
+
+    void pop() {
+        pos ++;
+        if (pos == size) advance_block();
+    }
+
+private:
+    std::FILE *file;
+    std::vector<T> current;
+    std::vector<T> next;
+    std::size_t pos = 0;
+    std::size_t size = 0;
+    std::future<std::pair<std::size_t, bool>> pending; //records read and whether the read failed
+
+    void prefetch() {
+        std::FILE *f = file;
+        T *dst = next.data();
+        std::size_t count = next.size();
+        pending = std::async(std::launch::async, [f, dst, count]() {
+            std::size_t records = std::fread(dst, sizeof(T), count, f);
+            return std::make_pair(records, std::ferror(f) != 0);
+        });
+    }
+
+    //a short read is the end of the run unless the stream reports an error
+    void advance_block() {
+        std::pair<std::size_t, bool> block = pending.get();
+        if (block.second) throw std::runtime_error("external_sort: read failed");
+        size = block.first;
+        pos = 0;
+        std::swap(current, next);
+        if (size > 0) prefetch();
+    }
+};
+
+//external sort helper class
+//loser tree over k run readers: tree[0] holds the index of the reader with the smallest front,
+//every internal node holds the loser of the match played there, so replacing the winner
+//replays only the log2(k) matches on its path to the root
+//exhausted readers lose every match, ties go to the lower run index to keep the merge stable
+template<typename T, typename Compare>
+class loser_tree {
+public:
+    loser_tree(std::vector<std::unique_ptr<run_reader<T>>> &run_readers, Compare compare)
+        : readers(run_readers), comp(compare), k(run_readers.size()), tree(run_readers.size(), 0) {
+        if (k > 1) tree[0] = build(1);
+    }
+
+    //index of the reader holding the next element, or k when all are exhausted
+    std::size_t winner() const {
+        return readers[tree[0]]->empty() ? k : tree[0];
+    }
+
+    //pop the winner's front and replay its path
+    void pop() {
+        std::size_t s = tree[0];
+        readers[s]->pop();
+        for (std::size_t t = (s + k) / 2; t > 0; t /= 2) {
+            if (beats(tree[t], s)) std::swap(tree[t], s);
+        }
+        tree[0] = s;
+    }
+
+private:
+    std::vector<std::unique_ptr<run_reader<T>>> &readers;
+    Compare comp;
+    std::size_t k;
+    std::vector<std::size_t> tree;
+
+    //true when reader a comes before reader b
+    bool beats(std::size_t a, std::size_t b) const {
+        if (readers[a]->empty()) return false;
+        if (readers[b]->empty()) return true;
+        if (comp(readers[b]->front(), readers[a]->front())) return false;
+        if (comp(readers[a]->front(), readers[b]->front())) return true;
+        return a < b;
+    }
+
+    //play the matches below node, nodes k..2k-1 are the leaves (readers 0..k-1)
+    std::size_t build(std::size_t node) {
+        if (node >= k) return node - k;
+        std::size_t l = build(2 * node);
+        std::size_t r = build(2 * node + 1);
+        if (beats(l, r)) {
+            tree[node] = r;
+            return l;
+        }
+        tree[node] = l;
+        return r;
+    }
+};
+
+//external sort helper function
+//write count records to file or throw
+template<typename T>
+void write_records(std::FILE *file, const T *records, std::size_t count) {
+    if (std::fwrite(records, sizeof(T), count, file) != count) {
+        throw std::runtime_error("external_sort: write failed");
+    }
+}
+
+//external sort helper function
+//flush the buffered records of a run file or throw, before the run is rewound and read back
+inline void flush_run(std::FILE *file) {
+    if (std::fflush(file) != 0) throw std::runtime_error("external_sort: write failed");
+}
+
+//external sort helper function
+//k-way merge of the runs into out, using blocks of block_records records per buffer
+template<typename T, typename Compare>
+void merge_runs(const std::vector<std::FILE *> &runs, std::FILE *out, std::size_t block_records, Compare comp) {
+    std::vector<std::unique_ptr<run_reader<T>>> readers;
+    for (std::FILE *run:runs) readers.emplace_back(new run_reader<T>(run, block_records));
+    loser_tree<T, Compare> tree(readers, comp);
+
+    std::vector<T> buffer;
+    buffer.reserve(block_records);
+    for (std::size_t w = tree.winner(); w != runs.size(); w = tree.winner()) {
+        buffer.push_back(readers[w]->front());
+        tree.pop();
+        if (buffer.size() == block_records) {
+            write_records(out, buffer.data(), buffer.size());
+            buffer.clear();
+        }
+    }
+    write_records(out, buffer.data(), buffer.size());
+}
+
+//external sort helper function
+//a new anonymous temporary file, removed automatically when closed
+inline std::FILE *make_run_file() {
+    std::FILE *file = std::tmpfile();
+    if (!file) throw std::runtime_error("external_sort: cannot create a temporary run file");
+    return file;
+}
+
+//sort the fixed width records of type T stored in input_path into output_path,
+//using about memory_budget bytes of memory however large the input is:
+//chunks that fit the budget are sorted with merge_sort_buffered and spilled as sorted runs
+//to temporary files, then merged with a loser tree, in several passes when there are more
+//runs than can be merged at once with blocks of at least EXTERNAL_MIN_BLOCK_BYTES
+//the sort is stable
+template<typename T, typename Compare>
+void external_sort(const std::string &input_path, const std::string &output_path, std::size_t memory_budget, Compare comp = std::less<T>()) {
+    static_assert(std::is_trivially_copyable<T>::value, "external_sort needs fixed width, trivially copyable records");
+
+    std::unique_ptr<std::FILE, int (*)(std::FILE *)> input(std::fopen(input_path.c_str(), "rb"), &std::fclose);
+    if (!input) throw std::runtime_error("external_sort: cannot open " + input_path);
+
+    //run formation: the chunk and the n / 2 merge buffer share the budget
+    std::size_t chunk_records = std::max<std::size_t>(1, 2 * memory_budget / (3 * sizeof(T)));
+    std::vector<T> chunk(chunk_records);
+    std::vector<T> buffer(chunk_records / 2);
+    std::vector<std::FILE *> runs; //sorted runs of the current pass
+    std::vector<std::FILE *> merged; //runs produced by the current merge pass
+    std::unique_ptr<std::FILE, int (*)(std::FILE *)> output(nullptr, &std::fclose);
+
+    //close every temporary run on the way out, including when an exception is thrown
+    struct run_closer {
+        std::vector<std::FILE *> &runs;
+        std::vector<std::FILE *> &merged;
+        ~run_closer() {
+            for (std::FILE *run:runs) std::fclose(run);
+            for (std::FILE *run:merged) std::fclose(run);
+        }
+    } closer{runs, merged};
+
+    while (true) {
+        std::size_t count = std::fread(chunk.data(), sizeof(T), chunk_records, input.get());
+        //a short read is the end of the input only if the stream reports no error
+        if (std::ferror(input.get())) throw std::runtime_error("external_sort: read failed on " + input_path);
+        if (count == 0) break;
+        chunk.resize(count);
+        merge_sort_buffered(chunk, buffer, comp);
+
+        if (runs.empty() && count < chunk_records) {
+            //the whole input fit into memory: write it straight to the output
+            output.reset(std::fopen(output_path.c_str(), "wb"));
+            if (!output) throw std::runtime_error("external_sort: cannot open " + output_path);
+            write_records(output.get(), chunk.data(), count);
+            if (std::fflush(output.get()) != 0) throw std::runtime_error("external_sort: write failed on " + output_path);
+            return;
+        }
+
+        runs.push_back(make_run_file());
+        write_records(runs.back(), chunk.data(), count);
+        flush_run(runs.back());
+        chunk.resize(chunk_records);
+    }
+    chunk = std::vector<T>();
+    buffer = std::vector<T>();
+
+    //merge passes: every reader holds two blocks and the output one more
+    std::size_t max_fan_in = std::max<std::size_t>(2, (memory_budget / EXTERNAL_MIN_BLOCK_BYTES - 1) / 2);
+    while (runs.size() > max_fan_in) {
+        std::size_t block_records = std::max<std::size_t>(1, memory_budget / ((2 * max_fan_in + 1) * sizeof(T)));
+        for (std::size_t i = 0; i < runs.size(); i += max_fan_in) {
+            std::vector<std::FILE *> group(runs.begin() + (std::ptrdiff_t)i, runs.begin() + (std::ptrdiff_t)std::min(i + max_fan_in, runs.size()));
+            merged.push_back(make_run_file());
+            merge_runs<T>(group, merged.back(), block_records, comp);
+            flush_run(merged.back());
+        }
+        for (std::FILE *run:runs) std::fclose(run);
+        runs.swap(merged);
+        merged.clear();
+    }
+
+    output.reset(std::fopen(output_path.c_str(), "wb"));
+    if (!output) throw std::runtime_error("external_sort: cannot open " + output_path);
+    if (runs.empty()) return; //empty input
+    std::size_t block_records = std::max<std::size_t>(1, memory_budget / ((2 * runs.size() + 1) * sizeof(T)));
+    merge_runs<T>(runs, output.get(), block_records, comp);
+    if (std::fflush(output.get()) != 0) throw std::runtime_error("external_sort: write failed on " + output_path);
+}
+
+
+//key extraction sort
+//sort_by_key helper struct
+//a precomputed key and the position of its element in the unsorted vector
+template<typename Key, typename Index>
+struct keyed_index {
+    Key key;
+    Index index;
+};
+
+//sort_by_key helper function
+//move the elements of vector in place so that position i receives the element at order[i]:
+//every cycle of the permutation is followed once, with one temporary per cycle,
+//so each element is moved exactly once plus two moves per cycle of length > 1
+//order is consumed, every visited entry is marked by pointing its index at itself
+template<typename Range, typename Key, typename Index>
+void apply_permutation(Range &vector, std::vector<keyed_index<Key, Index>> &order) {
+    using T = range_value_t<Range>;
+    for (std::size_t i = 0; i < order.size(); i ++) {
+        if ((std::size_t)order[i].index == i) continue;
+
+        T temp = std::move(vector[i]);
+        std::size_t j = i;
+        while ((std::size_t)order[j].index != i) {
+            std::size_t next = order[j].index;
+            vector[j] = std::move(vector[next]);
+            order[j].index = (Index)j;
+            j = next;
+        }
+        vector[j] = std::move(temp);
+        order[j].index = (Index)j;
+    }
+}
+
+//sort_by_key helper function
+//sort_by_key with Index wide enough to hold every position of vector
+template<typename Index, typename Range, typename KeyFn, typename Compare>
+void sort_by_key_indexed(Range &vector, KeyFn key_fn, Compare comp) {
+    using T = range_value_t<Range>;
+    using Key = typename std::decay<typename std::invoke_result<KeyFn &, const T &>::type>::type;
+    using Entry = keyed_index<Key, Index>;
+
+    std::vector<Entry> order;
+    order.reserve(vector.size());
+    count_allocation(comp, vector.size());
+    for (std::size_t i = 0; i < vector.size(); i ++) {
+        order.push_back(Entry{key_fn(vector[i]), (Index)i});
+    }
+
+    if constexpr (is_radix_sortable<Key>::value && (is_natural_less<Key, Compare>::value || is_natural_greater<Key, Compare>::value)) {
+        //the LSD passes are stable, so descending order complements the key instead of reversing afterwards
+        if (order.size() < RADIX_SORT_THRESHOLD) {
+            quick_sort_intro(order, [comp](const Entry &a, const Entry &b) {
+                return comp(a.key, b.key) || (!comp(b.key, a.key) && a.index < b.index);
+            });
+        }
+        else if (is_natural_greater<Key, Compare>::value) {
+            lsd_radix_sort(order, [](const Entry &el) { return (radix_key_t<Key>)~radix_key(el.key); });
+        }
+        else {
+            lsd_radix_sort(order, [](const Entry &el) { return radix_key(el.key); });
+        }
+    }
+    else {
+        //ties are broken by position, which makes the unstable introsort give the stable order
+        quick_sort_intro(order, [comp](const Entry &a, const Entry &b) {
+            return comp(a.key, b.key) || (!comp(b.key, a.key) && a.index < b.index);
+        });
+    }
+
+    apply_permutation(vector, order);
+}
+
+//sort vector by key_fn(el) under comp, calling key_fn exactly once per element:
+//the keys are cached next to the element positions in a packed (key, index) array, which is
+//radix sorted for arithmetic keys under std::less / std::greater and introsorted otherwise,
+//then the elements are moved to their places in one pass of cycle following
+//use it when the key is expensive to derive, e.g. a lower case copy of a string, or when the
+//elements are large and should be moved as few times as possible
+//the sort is stable
+template<typename RandomIt, typename KeyFn, typename Compare = std::less<>>
+void sort_by_key(RandomIt first, RandomIt last, KeyFn key_fn, Compare comp = Compare()) {
+    auto vector = make_sort_range(first, last);
+    if (vector.size() <= std::numeric_limits<std::uint32_t>::max()) {
+        sort_by_key_indexed<std::uint32_t>(vector, key_fn, comp);
+    }
+    else {
+        sort_by_key_indexed<std::size_t>(vector, key_fn, comp);
+    }
+}
+
+template<typename T, typename KeyFn, typename Compare = std::less<>>
+void sort_by_key(std::vector<T> &vector, KeyFn key_fn, Compare comp = Compare()) {
+    sort_by_key(vector.begin(), vector.end(), key_fn, comp);
+}
+
+
+//selection
+//partial_sort uses the bounded heap when k is at most this and at most n / PARTIAL_SORT_HEAP_RATIO,
+//quickselect followed by introsort on the prefix otherwise
+constexpr std::size_t PARTIAL_SORT_HEAP_MAX = 1024;
+constexpr std::size_t PARTIAL_SORT_HEAP_RATIO = 16;
+
+//selection helper function
+//move the median of [first, last) to last - 1 in linear worst case time (median of medians):
+//the median of every group of five is gathered at the front, and the median of those
+//medians is selected recursively, which keeps at least 30% of the range on either side of it
+template<typename Range, typename Compare>
+void median_of_medians(Range &vector, std::size_t first, std::size_t last, Compare comp = std::less<range_value_t<Range>>());
+
+//selection helper function
+//rearrange [first, last) so that vector[k] is the element that would be there if the range
+//were sorted, [first, k) holds no greater and (k, last) no smaller elements
+//introselect: lomuto partitions around a ninther pivot until depth_limit unbalanced steps were taken,
+//then median of medians pivots; after an unbalanced partition the elements equal to the pivot
+//are gathered next to it, so that inputs with many duplicates still shrink the range
+template<typename Range, typename Compare>
+void select_range(Range &vector, std::size_t first, std::size_t last, std::size_t k, std::size_t depth_limit, Compare comp = std::less<range_value_t<Range>>()) {
+    count_recursion(comp);
+    while (last - first > INSERTION_SORT_THRESHOLD) {
+        bool fallback = depth_limit == 0;
+        if (fallback) median_of_medians(vector, first, last, comp);
+        else swap(vector, choose_pivot(vector, first, last, comp), last - 1, comp);
+
+        std::size_t n = last - first;
+        std::size_t pivot = partition_inplace(vector, first, last - 1, comp);
+        std::size_t equal_end = pivot + 1;
+        if (k > pivot && 4 * (last - equal_end) > 3 * n) {
+            //unbalanced towards the right, where the elements equal to the pivot went:
+            //everything right of the pivot is no smaller, so no greater means equal
+            for (std::size_t i = pivot + 1; i < last; i ++) {
+                if (!comp(vector[pivot], vector[i])) swap(vector, i, equal_end ++, comp);
+            }
+        }
+
+        if (k < pivot) last = pivot;
+        else if (k >= equal_end) first = equal_end;
+        else return;
+        if (!fallback && 4 * (last - first) > 3 * n) depth_limit --; //more than three quarters were kept
+    }
+    insertion_sort_range(vector, first, last, comp);
+}
+
+template<typename Range, typename Compare>
+void median_of_medians(Range &vector, std::size_t first, std::size_t last, Compare comp) {
+    std::size_t groups = 0;
+    for (std::size_t group = first; group < last; group += 5) {
+        std::size_t group_last = std::min(group + 5, last);
+        insertion_sort_range(vector, group, group_last, comp);
+        swap(vector, first + groups, group + (group_last - group) / 2, comp);
+        groups ++;
+    }
+
+    select_range(vector, first, first + groups, first + groups / 2, 0, comp);
+    swap(vector, first + groups / 2, last - 1, comp);
+}
+
+//rearrange vector so that vector[k] is the element that would be at index k after sorting by comp,
+//with no greater elements before it and no smaller elements after it
+//expected linear time, linear worst case time through a median of medians fallback
+template<typename RandomIt, typename Compare = iterator_less<RandomIt>>
+void quick_select(RandomIt first, RandomIt last, std::size_t k, Compare comp = Compare()) {
+    auto vector = make_sort_range(first, last);
+    if (k >= vector.size()) return;
+
+    select_range(vector, 0, vector.size(), k, 2 * floor_log2(vector.size()), comp);
+}
+
+template<typename T, typename Compare>
+void quick_select(std::vector<T> &vector, std::size_t k, Compare comp = std::less<T>()) {
+    quick_select(vector.begin(), vector.end(), k, comp);
+}
+
+//selection helper function
+//make [0, k) a max heap of the k first elements of vector in comp order, scanning the rest once
+template<typename Range, typename Compare>
+void heap_select(Range &vector, std::size_t k, Compare comp = std::less<range_value_t<Range>>()) {
+    for (std::size_t i = k / 2; i > 0; i --) {
+        sift_down(vector, 0, i - 1, k, comp);
+    }
+    for (std::size_t i = k; i < vector.size(); i ++) {
+        if (comp(vector[i], vector[0])) {
+            swap(vector, 0, i, comp);
+            sift_down(vector, 0, 0, k, comp);
+        }
+    }
+}
+
+//sort the k first elements of vector in comp order into [0, k), the rest is left in unspecified order
+//small k keep a bounded max heap of the best k elements (O(n log k)),
+//larger k quickselect the boundary and introsort the prefix (O(n + k log k))
+template<typename RandomIt, typename Compare = iterator_less<RandomIt>>
+void partial_sort(RandomIt first, RandomIt last, std::size_t k, Compare comp = Compare()) {
+    auto vector = make_sort_range(first, last);
+    std::size_t n = vector.size();
+    if (k > n) k = n;
+    if (k == 0) return;
+
+    if (k <= PARTIAL_SORT_HEAP_MAX && k <= n / PARTIAL_SORT_HEAP_RATIO) {
+        heap_select(vector, k, comp);
+        heap_sort_range(vector, 0, k, comp);
+        return;
+    }
+
+    if (k == n) {
+        introsort_loop(vector, 0, n, 2 * floor_log2(n), comp);
+        return;
+    }
+    select_range(vector, 0, n, k - 1, 2 * floor_log2(n), comp);
+    introsort_loop(vector, 0, k - 1, 2 * floor_log2(k), comp); //vector[k - 1] is already in place
+}
+
+template<typename T, typename Compare>
+void partial_sort(std::vector<T> &vector, std::size_t k, Compare comp = std::less<T>()) {
+    partial_sort(vector.begin(), vector.end(), k, comp);
+}
+
+//return the k first elements of [first, last) in comp order, sorted, reading the input once:
+//a max heap holds the best k elements seen so far, so memory stays O(k) for any input length
+template<typename InputIt, typename Compare = std::less<typename std::iterator_traits<InputIt>::value_type>>
+std::vector<typename std::iterator_traits<InputIt>::value_type> top_k(InputIt first, InputIt last, std::size_t k, Compare comp = Compare()) {
+    std::vector<typename std::iterator_traits<InputIt>::value_type> heap;
+    if (k == 0) return heap;
+    heap.reserve(k);
+    count_allocation(comp, k);
+
+    for (; first != last && heap.size() < k; ++ first) heap.push_back(*first);
+    for (std::size_t i = heap.size() / 2; i > 0; i --) {
+        sift_down(heap, 0, i - 1, heap.size(), comp);
+    }
+    for (; first != last; ++ first) {
+        if (comp(*first, heap[0])) {
+            heap[0] = *first;
+            sift_down(heap, 0, 0, heap.size(), comp);
+        }
+    }
+
+    heap_sort_range(heap, 0, heap.size(), comp);
+    return heap;
+}
+
+
+//instrumentation
+//policies for sort_instrumented
+//run the sort with the caller's comparator, nothing is measured and nothing is paid
+struct no_instrumentation {
+    static constexpr bool count_operations = false;
+    static constexpr bool read_hardware_counters = false;
+};
+
+//count comparisons, swaps, scratch allocations and recursion depth through an instrumented comparator
+struct count_instrumentation {
+    static constexpr bool count_operations = true;
+    static constexpr bool read_hardware_counters = false;
+};
+
+//count operations and also read the cache and branch miss counters of the cpu
+struct hardware_instrumentation {
+    static constexpr bool count_operations = true;
+    static constexpr bool read_hardware_counters = true;
+};
+
+//statistics of one sort call
+//counts made through comp only: radix, sorting network and SIMD paths do not call it
+//hardware counts are -1 when they were not read or perf events are not available
+struct sort_stats {
+    std::size_t comparisons = 0;
+    std::size_t swaps = 0; //swaps through the swap helper, moves done by merges are not swaps
+    std::size_t allocations = 0; //scratch buffer allocations and reallocations
+    std::size_t max_depth = 0; //deepest recursion, 0 for the non recursive sorts
+    long long cache_misses = -1;
+    long long branch_misses = -1;
+};
+
+//hardware events read by perf_counter
+enum class perf_event {
+    cache_misses,
+    branch_misses,
+};
+
+//instrumentation helper class
+//hardware event counter of the calling thread and the threads it starts while counting
+//reads -1 when perf events are not available (non linux, or perf_event_paranoid too strict)
+class perf_counter {
+public:
+    explicit perf_counter(perf_event event) {
+#if defined(__linux__)
+        perf_event_attr attr{};
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = event == perf_event::cache_misses ? PERF_COUNT_HW_CACHE_MISSES : PERF_COUNT_HW_BRANCH_MISSES;
+        attr.disabled = 1;
+        attr.inherit = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+        (void)event;
+#endif
+    }
+
+    perf_counter(const perf_counter &) = delete;
+    perf_counter &operator=(const perf_counter &) = delete;
+
+    ~perf_counter() {
+#if defined(__linux__)
+        if (fd != -1) close(fd);
+#endif
+    }
+
+    void start() {
+#if defined(__linux__)
+        if (fd == -1) return;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+
+    long long stop() {
+#if defined(__linux__)
+        if (fd == -1) return -1;
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        long long count = 0;
+        if (read(fd, &count, sizeof(count)) != (ssize_t)sizeof(count)) return -1;
+        return count;
+#else
+        return -1;
+#endif
+    }
+
+private:
+    int fd = -1;
+};
+
+//sort [first, last) with sort_fn(first, last, comp) and return what Policy measured, e.g.
+//  sort_stats stats = sort_instrumented(v.begin(), v.end(), std::less<int>(),
+//      [](auto first, auto last, auto comp) { merge_sort(first, last, comp); });
+//counting policies hand sort_fn an instrumented_compare wrapping comp, no_instrumentation hands it comp
+template<typename Policy = count_instrumentation, typename RandomIt, typename Compare, typename SortFn>
+sort_stats sort_instrumented(RandomIt first, RandomIt last, Compare comp, SortFn sort_fn) {
+    sort_stats stats;
+    if constexpr (!Policy::count_operations) {
+        sort_fn(first, last, comp);
+        return stats;
+    }
+    else {
+        sort_counters counters;
+        instrumented_compare<Compare> counted{comp, &counters};
+
+        if constexpr (Policy::read_hardware_counters) {
+            perf_counter cache_misses(perf_event::cache_misses);
+            perf_counter branch_misses(perf_event::branch_misses);
+            cache_misses.start();
+            branch_misses.start();
+            sort_fn(first, last, counted);
+            stats.branch_misses = branch_misses.stop();
+            stats.cache_misses = cache_misses.stop();
+        }
+        else {
+            sort_fn(first, last, counted);
+        }
+
+        stats.comparisons = counters.comparisons.load();
+        stats.swaps = counters.swaps.load();
+        stats.allocations = counters.allocations.load();
+        stats.max_depth = counters.max_depth.load();
+        return stats;
+    }
+}
+
+template<typename Policy = count_instrumentation, typename T, typename Compare, typename SortFn>
+sort_stats sort_instrumented(std::vector<T> &vector, Compare comp, SortFn sort_fn) {
+    return sort_instrumented<Policy>(vector.begin(), vector.end(), comp, sort_fn);
+}
+
+
+#if defined(__cpp_lib_span)
+//span interface
+//the sorts also take a std::span and sort the viewed elements in place
+template<typename T, std::size_t Extent, typename Compare = std::less<T>>
+void bubble_sort(std::span<T, Extent> span, Compare comp = Compare()) {
+    bubble_sort(span.data(), span.data() + span.size(), comp);
+}
+
+template<typename T, std::size_t Extent, typename Compare = std::less<T>>
+void insertion_sort(std::span<T, Extent> span, Compare comp = Compare()) {
+    insertion_sort(span.data(), span.data() + span.size(), comp);
+}
+
+template<typename T, std::size_t Extent, typename Compare = std::less<T>>
+void selection_sort(std::span<T, Extent> span, Compare comp = Compare()) {
+    selection_sort(span.data(), span.data() + span.size(), comp);
+}
+
+template<typename T, std::size_t Extent, typename Compare = std::less<T>>
+void merge_sort(std::span<T, Extent> span, Compare comp = Compare()) {
+    merge_sort(span.data(), span.data() + span.size(), comp);
+}
+
+template<typename T, std::size_t Extent, typename Compare = std::less<T>>
+void quick_sort_inplace(std::span<T, Extent> span, Compare comp = Compare()) {
+    quick_sort_inplace(span.data(), span.data() + span.size(), comp);
+}
+
+template<typename T, std::size_t Extent, typename Compare = std::less<T>>
+void quick_sort_extra(std::span<T, Extent> span, Compare comp = Compare()) {
+    quick_sort_extra(span.data(), span.data() + span.size(), comp);
+}
+
+template<typename T, std::size_t Extent, typename Compare = std::less<T>>
+void heap_sort(std::span<T, Extent> span, Compare comp = Compare()) {
+    heap_sort(span.data(), span.data() + span.size(), comp);
+}
+
+template<typename T, std::size_t Extent, typename Compare = std::less<T>>
+void quick_sort_intro(std::span<T, Extent> span, Compare comp = Compare()) {
+    quick_sort_intro(span.data(), span.data() + span.size(), comp);
+}
+
+template<typename T, std::size_t Extent, typename Compare = std::less<T>>
+void quick_sort_block(std::span<T, Extent> span, Compare comp = Compare()) {
+    quick_sort_block(span.data(), span.data() + span.size(), comp);
+}
+
+template<typename T, std::size_t Extent, typename Compare = std::less<T>>
+void quick_sort_3way(std::span<T, Extent> span, Compare comp = Compare()) {
+    quick_sort_3way(span.data(), span.data() + span.size(), comp);
+}
+
+template<typename T, std::size_t Extent, typename Compare = std::less<T>>
+void quick_sort_extra_3way(std::span<T, Extent> span, Compare comp = Compare()) {
+    quick_sort_extra_3way(span.data(), span.data() + span.size(), comp);
+}
+
+template<typename T, std::size_t Extent, typename Compare = std::less<T>>
+void merge_sort_buffered(std::span<T, Extent> span, Compare comp = Compare()) {
+    merge_sort_buffered(span.data(), span.data() + span.size(), comp);
+}
+
+template<typename T, std::size_t Extent, typename Compare = std::less<T>>
+void merge_sort_parallel(std::span<T, Extent> span, Compare comp = Compare()) {
+    merge_sort_parallel(span.data(), span.data() + span.size(), comp);
+}
+
+template<typename T, std::size_t Extent, typename Compare = std::less<T>>
+void quick_sort_parallel(std::span<T, Extent> span, Compare comp = Compare()) {
+    quick_sort_parallel(span.data(), span.data() + span.size(), comp);
+}
+
+template<typename T, std::size_t Extent, typename Compare = std::less<T>>
+void merge_sort_inplace(std::span<T, Extent> span, Compare comp = Compare()) {
+    merge_sort_inplace(span.data(), span.data() + span.size(), comp);
+}
+
+template<typename T, std::size_t Extent, typename Compare = std::less<T>>
+void sample_sort(std::span<T, Extent> span, Compare comp = Compare()) {
+    sample_sort(span.data(), span.data() + span.size(), comp);
+}
+
+template<typename T, std::size_t Extent, typename Compare = std::less<T>>
+void radix_sort(std::span<T, Extent> span, Compare comp = Compare()) {
+    radix_sort(span.data(), span.data() + span.size(), comp);
+}
+
+template<typename T, std::size_t Extent, typename Compare = std::less<T>>
+void merge_sort_adaptive(std::span<T, Extent> span, Compare comp = Compare()) {
+    merge_sort_adaptive(span.data(), span.data() + span.size(), comp);
+}
+
+template<typename T, std::size_t Extent>
+void string_sort(std::span<T, Extent> span, std::size_t *lcp = nullptr) {
+    string_sort(span.data(), span.data() + span.size(), lcp);
+}
+
+//sort has no iterator overload, it would be ambiguous with std::sort under argument dependent lookup
+//spans with a static extent of at most SORT_NETWORK_MAX elements go through the static sorting network
+template<typename T, std::size_t Extent, typename Compare = std::less<T>>
+void sort(std::span<T, Extent> span, Compare comp = Compare()) {
+    if constexpr (Extent != std::dynamic_extent && Extent <= SORT_NETWORK_MAX) {
+        static_sort_network<Extent>(span, comp, std::make_index_sequence<static_network<Extent>::size>());
+    }
+    else if constexpr (is_radix_sortable<T>::value && (is_natural_less<T, Compare>::value || is_natural_greater<T, Compare>::value)) {
+        radix_sort(span.data(), span.data() + span.size(), comp);
+    }
+    else if constexpr (is_string_sortable<T>::value && is_natural_less<T, Compare>::value) {
+        string_sort(span.data(), span.data() + span.size());
+    }
+    else {
+        quick_sort_intro(span.data(), span.data() + span.size(), comp);
+    }
+}
+
+template<typename T, std::size_t Extent, typename KeyFn, typename Compare = std::less<>>
+void sort_by_key(std::span<T, Extent> span, KeyFn key_fn, Compare comp = Compare()) {
+    sort_by_key(span.data(), span.data() + span.size(), key_fn, comp);
+}
+
+template<typename T, std::size_t Extent, typename Compare = std::less<T>>
+void quick_select(std::span<T, Extent> span, std::size_t k, Compare comp = Compare()) {
+    quick_select(span.data(), span.data() + span.size(), k, comp);
+}
+
+template<typename T, std::size_t Extent, typename Compare = std::less<T>>
+void partial_sort(std::span<T, Extent> span, std::size_t k, Compare comp = Compare()) {
+    partial_sort(span.data(), span.data() + span.size(), k, comp);
+}
+#endif
 
 #endif //VE281P1_SORT_HPP
\ No newline at end of file